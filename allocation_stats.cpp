@@ -0,0 +1,116 @@
+#include "allocation_stats.h"
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+using namespace std;
+
+namespace {
+
+// Liczniki są zwykłymi zmiennymi statycznymi (inicjalizacja stała), dzięki czemu
+// działają także dla alokacji wykonywanych przed main
+atomic<uint64_t> allocatedBytes{0};
+atomic<uint64_t> allocationCount{0};
+atomic<uint64_t> liveBytes{0};
+atomic<uint64_t> peakLiveBytes{0};
+
+// Rozmiar bloku odczytywany jest z alokatora (malloc_usable_size), więc operator
+// delete bez rozmiaru odejmuje dokładnie to, co dodał new
+void record_allocation(void* p) {
+    uint64_t size = malloc_usable_size(p);
+    allocatedBytes.fetch_add(size, memory_order_relaxed);
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    uint64_t live = liveBytes.fetch_add(size, memory_order_relaxed) + size;
+    uint64_t peak = peakLiveBytes.load(memory_order_relaxed);
+    while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {
+    }
+}
+
+void record_deallocation(void* p) {
+    if (p) {
+        liveBytes.fetch_sub(malloc_usable_size(p), memory_order_relaxed);
+    }
+}
+
+void* try_allocate(size_t size, size_t alignment) {
+    if (size == 0) {
+        size = 1;
+    }
+    void* p = nullptr;
+    if (alignment <= alignof(max_align_t)) {
+        p = malloc(size);
+    } else if (posix_memalign(&p, alignment, size) != 0) {
+        p = nullptr;
+    }
+    if (p) {
+        record_allocation(p);
+    }
+    return p;
+}
+
+// Zachowanie standardowego operatora new: ponawianie po wywołaniu new_handler
+void* allocate(size_t size, size_t alignment) {
+    while (true) {
+        if (void* p = try_allocate(size, alignment)) {
+            return p;
+        }
+        new_handler handler = get_new_handler();
+        if (!handler) {
+            throw bad_alloc();
+        }
+        handler();
+    }
+}
+
+void deallocate(void* p) {
+    record_deallocation(p);
+    free(p);
+}
+
+} // namespace
+
+AllocationScope::AllocationScope()
+    : startAllocatedBytes(allocatedBytes.load(memory_order_relaxed)),
+      startAllocations(allocationCount.load(memory_order_relaxed)),
+      startLiveBytes(liveBytes.load(memory_order_relaxed)) {
+    peakLiveBytes.store(startLiveBytes, memory_order_relaxed);
+}
+
+AllocationStats AllocationScope::stop() const {
+    AllocationStats stats;
+    stats.allocatedBytes = allocatedBytes.load(memory_order_relaxed) - startAllocatedBytes;
+    stats.allocations = allocationCount.load(memory_order_relaxed) - startAllocations;
+    uint64_t peak = peakLiveBytes.load(memory_order_relaxed);
+    stats.peakLiveBytes = peak > startLiveBytes ? peak - startLiveBytes : 0;
+    return stats;
+}
+
+// Zastąpione globalne operatory new/delete
+
+void* operator new(size_t size) { return allocate(size, 0); }
+void* operator new[](size_t size) { return allocate(size, 0); }
+void* operator new(size_t size, align_val_t alignment) { return allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, align_val_t alignment) { return allocate(size, static_cast<size_t>(alignment)); }
+
+void* operator new(size_t size, const nothrow_t&) noexcept { return try_allocate(size, 0); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return try_allocate(size, 0); }
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return try_allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return try_allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { deallocate(p); }
+void operator delete[](void* p) noexcept { deallocate(p); }
+void operator delete(void* p, size_t) noexcept { deallocate(p); }
+void operator delete[](void* p, size_t) noexcept { deallocate(p); }
+void operator delete(void* p, align_val_t) noexcept { deallocate(p); }
+void operator delete[](void* p, align_val_t) noexcept { deallocate(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { deallocate(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { deallocate(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { deallocate(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { deallocate(p); }
+void operator delete(void* p, align_val_t, const nothrow_t&) noexcept { deallocate(p); }
+void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept { deallocate(p); }
@@ -0,0 +1,33 @@
+#ifndef ALLOCATION_STATS_H
+#define ALLOCATION_STATS_H
+
+#include <cstdint>
+
+using namespace std;
+
+// Liczniki alokacji sterty prowadzone przez zastąpione operatory new/delete
+// (allocation_stats.cpp). Obejmują wszystkie wątki procesu, więc pomiar ma sens
+// tylko dla jednego algorytmu naraz - tak jak uruchamia je main.
+
+// Wynik pomiaru jednego odcinka programu
+struct AllocationStats {
+    uint64_t allocatedBytes = 0;  // suma rozmiarów wszystkich alokacji
+    uint64_t allocations = 0;     // liczba alokacji
+    uint64_t peakLiveBytes = 0;   // największa zajętość sterty ponad stan z początku pomiaru
+};
+
+// Pomiar od konstrukcji do stop(). Rozpoczęcie pomiaru zeruje globalny szczyt
+// zajętości, więc pomiary nie mogą się zagnieżdżać.
+class AllocationScope {
+public:
+    AllocationScope();
+
+    AllocationStats stop() const;
+
+private:
+    uint64_t startAllocatedBytes;
+    uint64_t startAllocations;
+    uint64_t startLiveBytes;
+};
+
+#endif // ALLOCATION_STATS_H
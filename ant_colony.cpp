@@ -0,0 +1,269 @@
+#include "tsp.h"
+#include "barrier.h"
+#include "candidate_list.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+// Prawdopodobieństwo, że zbieżna kolonia zbuduje najlepszą trasę - wyznacza
+// stosunek tau_min / tau_max w MAX-MIN Ant System
+const double BEST_TOUR_PROBABILITY = 0.05;
+
+// Wagi przejścia z miasta do jego kandydatów: weights[c] = choice[c] * unvisited[candidates[c]],
+// zwraca sumę wag. unvisited ma wartości 1.0 / 0.0, więc odwiedzone miasta dostają wagę 0.
+// Jądro wektorowe: AVX2 (gather 4 masek) albo SSE2 (domyślne na x86-64; 2 maski
+// ładowane spod indeksów), z resztą skalarną.
+double candidate_weights(const double* choice, const int* candidates, const double* unvisited, double* weights, int k) {
+    int c = 0;
+    double total = 0.0;
+#if defined(__AVX2__)
+    __m256d sum = _mm256_setzero_pd();
+    for (; c + 4 <= k; c += 4) {
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(candidates + c));
+        __m256d mask = _mm256_i32gather_pd(unvisited, index, sizeof(double));
+        __m256d weight = _mm256_mul_pd(_mm256_loadu_pd(choice + c), mask);
+        _mm256_storeu_pd(weights + c, weight);
+        sum = _mm256_add_pd(sum, weight);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__SSE2__)
+    __m128d sum = _mm_setzero_pd();
+    for (; c + 2 <= k; c += 2) {
+        __m128d mask = _mm_setr_pd(unvisited[candidates[c]], unvisited[candidates[c + 1]]);
+        __m128d weight = _mm_mul_pd(_mm_loadu_pd(choice + c), mask);
+        _mm_storeu_pd(weights + c, weight);
+        sum = _mm_add_pd(sum, weight);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, sum);
+    total = lanes[0] + lanes[1];
+#endif
+    for (; c < k; ++c) {
+        weights[c] = choice[c] * unvisited[candidates[c]];
+        total += weights[c];
+    }
+    return total;
+}
+
+// Nieodwiedzone miasto o największej wartości choice - wybór, gdy wszyscy
+// kandydaci są już odwiedzeni. Pętla po ciągłym wierszu macierzy.
+int best_unvisited(const double* choice, const double* unvisited, int n) {
+    int best = -1;
+    double bestValue = -1.0;
+    for (int j = 0; j < n; ++j) {
+        double value = unvisited[j] > 0.0 ? choice[j] : -1.0;
+        if (value > bestValue) {
+            bestValue = value;
+            best = j;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+// MAX-MIN Ant System. Feromon i wartości wyboru choice = tau * eta^beta
+// (alfa = 1) trzymane są w ciągłych macierzach, eta^beta liczone raz. Mrówka
+// wybiera następne miasto spośród kandydatów proporcjonalnie do choice
+// (wagi liczone wektorowo), a gdy wszyscy są odwiedzeni - miasto o największym
+// choice. Mrówki są budowane równolegle przez stałe wątki; po każdej iteracji
+// (na barierze) feromon paruje, a ślad zostawia najlepsza mrówka iteracji
+// (co 10. iteracja - najlepsza dotąd trasa). Feromon ograniczony jest do
+// [tau_min, tau_max], a tau_max wynika z najlepszej dotąd trasy.
+Route solve_ant_colony(const DistanceMatrix& distanceMatrix, int ants, int maxIterations, int& iteration_count,
+                       double beta, double evaporation, int candidates, unsigned seed, int threads) {
+    int n = distanceMatrix.size();
+    iteration_count = 0;
+    if (n <= 3) {
+        return generate_random_solution(n, distanceMatrix);
+    }
+    if (ants <= 0) {
+        ants = n;
+    }
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    threads = min(threads, ants);
+    candidates = clamp(candidates, 1, n - 1);
+    CandidateList candidateList(distanceMatrix, candidates);
+    int k = candidateList.k();
+
+    // Trasa najbliższego sąsiada - początkowa najlepsza trasa i skala feromonu
+    Route bestRoute;
+    {
+        vector<char> visited(n, 0);
+        bestRoute.cities.push_back(0);
+        visited[0] = 1;
+        for (int step = 1; step < n; ++step) {
+            int current = bestRoute.cities.back();
+            int next = -1;
+            for (int j = 0; j < n; ++j) {
+                if (!visited[j] && (next < 0 || distanceMatrix(current, j) < distanceMatrix(current, next))) {
+                    next = j;
+                }
+            }
+            visited[next] = 1;
+            bestRoute.cities.push_back(next);
+        }
+        bestRoute.cost = check_cost(bestRoute.cities, distanceMatrix);
+        bestRoute.hash = tour_hash(bestRoute.cities);
+    }
+
+    BasicDistanceMatrix<double> etaBeta(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            etaBeta(i, j) = i == j ? 0.0 : pow(1.0 / max(distanceMatrix(i, j), 1e-9), beta);
+        }
+    }
+    double root = pow(BEST_TOUR_PROBABILITY, 1.0 / n);
+    double tauMax = 0.0;
+    double tauMin = 0.0;
+    auto update_limits = [&]() {
+        tauMax = 1.0 / (evaporation * bestRoute.cost);
+        tauMin = tauMax * (1.0 - root) / ((n / 2.0 - 1.0) * root);
+    };
+    update_limits();
+    BasicDistanceMatrix<double> pheromone(n, tauMax);
+    BasicDistanceMatrix<double> choice(n);
+    // choice dla kandydatów w kolejności list kandydatów - wiersz na miasto
+    vector<double> candidateChoice(static_cast<size_t>(n) * k);
+    auto update_choice = [&]() {
+        for (int i = 0; i < n; ++i) {
+            double* choiceRow = choice.row(i);
+            const double* pheromoneRow = pheromone.row(i);
+            const double* etaRow = etaBeta.row(i);
+            for (int j = 0; j < n; ++j) {
+                choiceRow[j] = pheromoneRow[j] * etaRow[j];
+            }
+            const int* candidateRow = candidateList.of(i);
+            for (int c = 0; c < k; ++c) {
+                candidateChoice[static_cast<size_t>(i) * k + c] = choiceRow[candidateRow[c]];
+            }
+        }
+    };
+    update_choice();
+
+    Trace trace("ant_colony");
+
+    vector<Route> antRoutes(ants, Route{vector<int>(n), 0.0});
+    bool directed = !distanceMatrix.symmetric();
+    auto deposit = [&](const Route& route) {
+        double amount = 1.0 / route.cost;
+        for (int p = 0; p < n; ++p) {
+            int a = route.cities[p];
+            int b = route.cities[(p + 1) % n];
+            pheromone(a, b) += amount;
+            if (!directed) {
+                pheromone(b, a) += amount;
+            }
+        }
+    };
+
+    // Aktualizacja feromonu - wykonywana przez ostatni wątek na barierze
+    bool finished = maxIterations <= 0;
+    auto update = [&]() {
+        const Route* iterationBest = &antRoutes[0];
+        for (const Route& route : antRoutes) {
+            if (route.cost < iterationBest->cost) {
+                iterationBest = &route;
+            }
+        }
+        ++iteration_count;
+        if (iterationBest->cost < bestRoute.cost) {
+            bestRoute = *iterationBest;
+            // Trasy mrówek budowane są w miejscu - skrót tylko dla nowej najlepszej
+            bestRoute.hash = tour_hash(bestRoute.cities);
+            update_limits();
+        }
+        for (int i = 0; i < n; ++i) {
+            double* row = pheromone.row(i);
+            for (int j = 0; j < n; ++j) {
+                row[j] *= 1.0 - evaporation;
+            }
+        }
+        deposit(iteration_count % 10 == 0 ? bestRoute : *iterationBest);
+        for (int i = 0; i < n; ++i) {
+            double* row = pheromone.row(i);
+            for (int j = 0; j < n; ++j) {
+                row[j] = min(tauMax, max(tauMin, row[j]));
+            }
+        }
+        update_choice();
+        trace.record(iteration_count, bestRoute.cost);
+        finished = iteration_count >= maxIterations;
+    };
+    Barrier barrier(threads, update);
+
+    auto work = [&](int worker) {
+        RandomStream stream(seed, worker);
+        mt19937& rgen = random_engine();
+        uniform_real_distribution<double> u(0.0, 1.0);
+        uniform_int_distribution<int> startCity(0, n - 1);
+        vector<double> mask(n);
+        vector<double> weights(k);
+        while (!finished) {
+            for (int ant = worker; ant < ants; ant += threads) {
+                Route& route = antRoutes[ant];
+                fill(mask.begin(), mask.end(), 1.0);
+                int current = startCity(rgen);
+                route.cities[0] = current;
+                mask[current] = 0.0;
+                double cost = 0.0;
+                for (int step = 1; step < n; ++step) {
+                    const int* candidateRow = candidateList.of(current);
+                    double total = candidate_weights(candidateChoice.data() + static_cast<size_t>(current) * k, candidateRow,
+                                                     mask.data(), weights.data(), k);
+                    int next = -1;
+                    if (total > 0.0) {
+                        // Ruletka; przy błędzie zaokrąglenia zostaje ostatni kandydat z niezerową wagą
+                        double target = u(rgen) * total;
+                        for (int c = 0; c < k; ++c) {
+                            if (weights[c] > 0.0) {
+                                next = candidateRow[c];
+                                if ((target -= weights[c]) <= 0.0) {
+                                    break;
+                                }
+                            }
+                        }
+                    } else {
+                        next = best_unvisited(choice.row(current), mask.data(), n);
+                    }
+                    route.cities[step] = next;
+                    mask[next] = 0.0;
+                    cost += distanceMatrix(current, next);
+                    current = next;
+                }
+                route.cost = cost + distanceMatrix(current, route.cities[0]);
+            }
+            barrier.arrive_and_wait();
+        }
+    };
+
+    if (threads == 1) {
+        work(0);
+    } else {
+        vector<thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back(work, t);
+        }
+        for (auto& worker : pool) {
+            worker.join();
+        }
+    }
+    return bestRoute;
+}
@@ -0,0 +1,39 @@
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+using namespace std;
+
+// Bariera dla stałej liczby wątków; ostatni przybywający wykonuje completion,
+// zanim pozostałe zostaną zwolnione
+class Barrier {
+public:
+    Barrier(int count, function<void()> completion) : count(count), waiting(0), completion(move(completion)) {}
+
+    void arrive_and_wait() {
+        unique_lock<mutex> lock(guard);
+        long long phase = generation;
+        if (++waiting == count) {
+            completion();
+            waiting = 0;
+            ++generation;
+            released.notify_all();
+            return;
+        }
+        released.wait(lock, [&] { return generation != phase; });
+    }
+
+private:
+    mutex guard;
+    condition_variable released;
+    int count;
+    int waiting;
+    long long generation = 0;
+    function<void()> completion;
+};
+
+#endif // BARRIER_H
@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "tsp.h"
+#include "allocation_stats.h"
+
+using namespace std;
+using namespace std::chrono;
+
+namespace {
+
+// Instancja testowa: wygenerowana losowo albo wczytana z pliku
+struct Instance {
+    string name;
+    unsigned seed;
+    DistanceMatrix distanceMatrix;
+};
+
+// Pojedyncze uruchomienie solvera
+struct Run {
+    double milliseconds;
+    int iterations;
+    double cost;
+    AllocationStats memory;
+};
+
+// Solver z parametrami ustalonymi dla benchmarku. maxCities ogranicza rozmiar
+// instancji (algorytmy dokładne i pełny przegląd mają koszt wykładniczy).
+struct Solver {
+    string name;
+    int maxCities;
+    function<Route(const DistanceMatrix&, unsigned seed, int& iterations)> solve;
+};
+
+struct Options {
+    vector<int> sizes{12, 50, 200};
+    int seeds = 3;
+    int warmup = 1;
+    int repetitions = 5;
+    int maxIterations = 1000;
+    double timeLimit = 5.0;
+    vector<string> only;
+    vector<string> files;
+    string output;
+};
+
+// Losowe miasta w kwadracie 1000 x 1000 z odległością euklidesową
+DistanceMatrix random_euclidean(int numberOfCities, unsigned seed) {
+    mt19937 engine(seed);
+    uniform_real_distribution<double> coordinate(0.0, 1000.0);
+    vector<double> x(numberOfCities), y(numberOfCities);
+    for (int i = 0; i < numberOfCities; ++i) {
+        x[i] = coordinate(engine);
+        y[i] = coordinate(engine);
+    }
+    DistanceMatrix matrix(numberOfCities);
+    for (int i = 0; i < numberOfCities; ++i) {
+        for (int j = 0; j < numberOfCities; ++j) {
+            matrix(i, j) = hypot(x[i] - x[j], y[i] - y[j]);
+        }
+    }
+    matrix.update_symmetry();
+    return matrix;
+}
+
+vector<Solver> make_solvers(const Options& options) {
+    int maxIterations = options.maxIterations;
+    double timeLimit = options.timeLimit;
+    auto T = [](int iteration) -> double { return 10000.0 / iteration; };
+    return {
+        {"hill_climbing", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned, int& iterations) {
+             return solve_hill_climbing(dm, maxIterations, iterations, ImprovementStrategy::Best,
+                                        NeighborhoodType::TwoOpt, 10);
+         }},
+        {"random_hill_climbing", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned, int& iterations) {
+             return solve_random_hill_climbing(dm, maxIterations, iterations);
+         }},
+        {"multi_start", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned seed, int& iterations) {
+             return solve_multi_start(dm, 16, maxIterations, iterations, false, ImprovementStrategy::Best,
+                                      NeighborhoodType::TwoOpt, 10, 0.0, seed);
+         }},
+        {"tabu", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned, int& iterations) {
+             return solve_tabu(dm, 10, maxIterations, iterations, NeighborhoodType::TwoOpt, 10);
+         }},
+        {"lin_kernighan", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned, int& iterations) {
+             return solve_lin_kernighan(dm, maxIterations, iterations);
+         }},
+        {"simulated_annealing", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned, int& iterations) {
+             return solve_simulated_annealing(dm, T, maxIterations, iterations, NeighborhoodType::TwoOpt);
+         }},
+        {"parallel_tempering", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned seed, int& iterations) {
+             vector<ReplicaStats> stats;
+             return solve_parallel_tempering(dm, temperature_ladder(1.0, 1000.0, 8), maxIterations, iterations,
+                                             stats, 100, NeighborhoodType::TwoOpt, seed);
+         }},
+        {"genetic", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned seed, int& iterations) {
+             return solve_genetic(dm, 100, maxIterations, iterations, CrossoverType::Order, 0.1, 0, 50, 2, seed);
+         }},
+        {"ant_colony", numeric_limits<int>::max(),
+         [=](const DistanceMatrix& dm, unsigned seed, int& iterations) {
+             return solve_ant_colony(dm, 0, maxIterations / 10, iterations, 3.0, 0.02, 15, seed);
+         }},
+        {"full_review", 12,
+         [=](const DistanceMatrix& dm, unsigned, int& iterations) {
+             return solve_full_review(dm, numeric_limits<int>::max(), iterations);
+         }},
+        {"held_karp", 18,
+         [=](const DistanceMatrix& dm, unsigned, int& iterations) { return solve_held_karp(dm, iterations); }},
+        {"branch_and_bound", BRANCH_AND_BOUND_MAX_CITIES,
+         [=](const DistanceMatrix& dm, unsigned, int& iterations) {
+             double gap;
+             return solve_branch_and_bound(dm, timeLimit, iterations, gap);
+         }},
+    };
+}
+
+// Percentyl metodą najbliższej rangi
+double percentile(vector<double> values, double p) {
+    sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(ceil(p * values.size()));
+    return values[min(values.size(), max<size_t>(rank, 1)) - 1];
+}
+
+double median(vector<double> values) {
+    sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+}
+
+vector<string> split(const string& text, char separator) {
+    vector<string> parts;
+    istringstream iss(text);
+    string part;
+    while (getline(iss, part, separator)) {
+        if (!part.empty()) {
+            parts.push_back(part);
+        }
+    }
+    return parts;
+}
+
+string json_string(const string& text) {
+    string escaped = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+} // namespace
+
+// Benchmark wszystkich solverów: każda instancja (rozmiar x ziarno oraz pliki)
+// jest rozwiązywana przez każdy solver obsługujący jej rozmiar - najpierw warmup
+// uruchomień rozgrzewających, potem repetitions mierzonych. Wynik w formacie JSON:
+// mediana i 95. percentyl czasu, iteracje na sekundę, luka kosztu względem
+// najlepszej trasy znalezionej na danej instancji przez którykolwiek solver
+// oraz mediany liczników alokacji.
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-sizes" && i + 1 < argc) {
+            options.sizes.clear();
+            for (const string& size : split(argv[++i], ',')) {
+                options.sizes.push_back(atoi(size.c_str()));
+            }
+        } else if (arg == "-seeds" && i + 1 < argc) {
+            options.seeds = atoi(argv[++i]);
+        } else if (arg == "-warmup" && i + 1 < argc) {
+            options.warmup = atoi(argv[++i]);
+        } else if (arg == "-reps" && i + 1 < argc) {
+            options.repetitions = max(1, atoi(argv[++i]));
+        } else if (arg == "-i" && i + 1 < argc) {
+            options.maxIterations = atoi(argv[++i]);
+        } else if (arg == "-bb" && i + 1 < argc) {
+            options.timeLimit = atof(argv[++i]);
+        } else if (arg == "-solvers" && i + 1 < argc) {
+            options.only = split(argv[++i], ',');
+        } else if (arg == "-o" && i + 1 < argc) {
+            options.output = argv[++i];
+        } else if (!arg.empty() && arg[0] != '-') {
+            options.files.push_back(arg);
+        } else {
+            cerr << "Użycie: " << argv[0]
+                 << " [-sizes 12,50,200] [-seeds 3] [-warmup 1] [-reps 5] [-i 1000] [-bb 5]"
+                    " [-solvers nazwa,...] [-o wynik.json] [plik ...]" << endl;
+            return 1;
+        }
+    }
+
+    vector<Solver> solvers;
+    for (Solver& solver : make_solvers(options)) {
+        if (options.only.empty() || find(options.only.begin(), options.only.end(), solver.name) != options.only.end()) {
+            solvers.push_back(move(solver));
+        }
+    }
+
+    vector<Instance> instances;
+    for (int size : options.sizes) {
+        for (int seed = 1; seed <= options.seeds; ++seed) {
+            instances.push_back({"random-" + to_string(size) + "-" + to_string(seed), static_cast<unsigned>(seed),
+                                 random_euclidean(size, seed)});
+        }
+    }
+    for (const string& file : options.files) {
+        instances.push_back({file, 1, read_instance(file).second});
+    }
+
+    ostringstream json;
+    json << setprecision(10);
+    json << "{\n  \"config\": {\"warmup\": " << options.warmup << ", \"repetitions\": " << options.repetitions
+         << ", \"max_iterations\": " << options.maxIterations << ", \"time_limit_s\": " << options.timeLimit
+         << "},\n  \"results\": [";
+
+    bool firstResult = true;
+    for (const Instance& instance : instances) {
+        int numberOfCities = instance.distanceMatrix.size();
+        vector<pair<const Solver*, vector<Run>>> measured;
+        for (const Solver& solver : solvers) {
+            if (numberOfCities > solver.maxCities) {
+                continue;
+            }
+            cerr << instance.name << ": " << solver.name << endl;
+            vector<Run> runs;
+            for (int rep = -options.warmup; rep < options.repetitions; ++rep) {
+                // Powtórzenie rep używa własnego strumienia generatora - wyniki są powtarzalne
+                unsigned stream = static_cast<unsigned>(rep + options.warmup);
+                seed_random_engine(instance.seed, stream);
+                int iterations = 0;
+                AllocationScope allocations;
+                auto start = steady_clock::now();
+                Route route = instance.distanceMatrix.empty()
+                                  ? Route{}
+                                  : solver.solve(instance.distanceMatrix, instance.seed * 1000 + stream, iterations);
+                duration<double, milli> elapsed = steady_clock::now() - start;
+                AllocationStats memory = allocations.stop();
+                if (rep >= 0) {
+                    runs.push_back({elapsed.count(), iterations, route.cost, memory});
+                }
+            }
+            measured.emplace_back(&solver, move(runs));
+        }
+
+        // Odniesienie dla luki - najlepszy koszt na instancji (optimum, jeśli działał solver dokładny)
+        double reference = numeric_limits<double>::infinity();
+        for (const auto& [solver, runs] : measured) {
+            for (const Run& run : runs) {
+                reference = min(reference, run.cost);
+            }
+        }
+
+        for (const auto& [solver, runs] : measured) {
+            vector<double> times, rates, costs, peaks, allocated, counts;
+            for (const Run& run : runs) {
+                times.push_back(run.milliseconds);
+                rates.push_back(run.milliseconds > 0.0 ? 1000.0 * run.iterations / run.milliseconds : 0.0);
+                costs.push_back(run.cost);
+                peaks.push_back(run.memory.peakLiveBytes);
+                allocated.push_back(run.memory.allocatedBytes);
+                counts.push_back(run.memory.allocations);
+            }
+            // Różnice rzędu błędu zaokrąglenia (ten sam cykl zsumowany w innej kolejności) to luka 0
+            auto gap = [&](double cost) {
+                return reference > 0.0 && cost - reference > 1e-9 * reference ? (cost - reference) / reference : 0.0;
+            };
+            double bestCost = *min_element(costs.begin(), costs.end());
+            double medianCost = median(costs);
+
+            json << (firstResult ? "\n" : ",\n");
+            firstResult = false;
+            json << "    {\"solver\": " << json_string(solver->name) << ", \"instance\": " << json_string(instance.name)
+                 << ", \"cities\": " << numberOfCities
+                 << ",\n     \"time_ms\": {\"median\": " << median(times) << ", \"p95\": " << percentile(times, 0.95)
+                 << ", \"min\": " << *min_element(times.begin(), times.end()) << "}"
+                 << ",\n     \"iterations_per_second\": " << median(rates)
+                 << ",\n     \"cost\": {\"median\": " << medianCost << ", \"best\": " << bestCost
+                 << ", \"reference\": " << reference << "}"
+                 << ",\n     \"gap\": {\"median\": " << gap(medianCost) << ", \"best\": " << gap(bestCost) << "}"
+                 << ",\n     \"memory\": {\"peak_live_bytes\": " << median(peaks)
+                 << ", \"allocated_bytes\": " << median(allocated) << ", \"allocations\": " << median(counts) << "}}";
+        }
+    }
+    json << "\n  ]\n}\n";
+
+    if (options.output.empty()) {
+        cout << json.str();
+    } else {
+        ofstream file(options.output);
+        if (!file) {
+            cerr << "Nie można zapisać pliku: " << options.output << endl;
+            return 1;
+        }
+        file << json.str();
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "binary_matrix.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+// Przesunięcie macierzy w pliku - wyrównanie do strony zapewnia wyrównanie
+// wierszy do 64 bajtów także po zmapowaniu
+const uint64_t PAYLOAD_ALIGNMENT = 4096;
+
+[[noreturn]] void fail(const string& filename, const string& message) {
+    cerr << "Plik " << filename << ": " << message << endl;
+    exit(1);
+}
+
+} // namespace
+
+uint64_t checksum_payload(const void* data, size_t bytes) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, 8);
+        hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+    for (; i < bytes; ++i) {
+        hash = (hash ^ p[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool is_binary_matrix_file(const string& filename) {
+    ifstream file(filename, ios::binary);
+    char magic[sizeof(BINARY_MATRIX_MAGIC)];
+    return file.read(magic, sizeof(magic)) && memcmp(magic, BINARY_MATRIX_MAGIC, sizeof(magic)) == 0;
+}
+
+bool write_binary_matrix(const string& filename, const vector<string>& cityNames, const DistanceMatrix& distanceMatrix) {
+    ofstream file(filename, ios::binary | ios::trunc);
+    if (!file) {
+        cerr << "Nie można zapisać pliku: " << filename << endl;
+        return false;
+    }
+
+    string names;
+    for (const string& name : cityNames) {
+        names += name;
+        names += '\0';
+    }
+    uint64_t payloadBytes = distanceMatrix.size() * distanceMatrix.stride() * sizeof(double);
+
+    BinaryMatrixHeader header{};
+    memcpy(header.magic, BINARY_MATRIX_MAGIC, sizeof(header.magic));
+    header.version = BINARY_MATRIX_VERSION;
+    header.elementType = BinaryElementType::Float64;
+    header.cities = distanceMatrix.size();
+    header.stride = distanceMatrix.stride();
+    header.flags = distanceMatrix.symmetric() ? BINARY_MATRIX_SYMMETRIC : 0;
+    header.payloadOffset = PAYLOAD_ALIGNMENT;
+    header.namesOffset = header.payloadOffset + payloadBytes;
+    header.namesSize = names.size();
+    header.checksum = checksum_payload(distanceMatrix.data(), payloadBytes);
+
+    vector<char> padding(header.payloadOffset - sizeof(header), 0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding.data(), padding.size());
+    file.write(reinterpret_cast<const char*>(distanceMatrix.data()), payloadBytes);
+    file.write(names.data(), names.size());
+    if (!file) {
+        cerr << "Błąd zapisu pliku: " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+pair<vector<string>, DistanceMatrix> map_binary_matrix(const string& filename, bool verify) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Nie można otworzyć pliku: " << filename << endl;
+        exit(1);
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<uint64_t>(status.st_size) < sizeof(BinaryMatrixHeader)) {
+        close(fd);
+        fail(filename, "za krótki na nagłówek macierzy binarnej");
+    }
+    size_t length = status.st_size;
+    void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // odwzorowanie pozostaje ważne po zamknięciu deskryptora
+    if (address == MAP_FAILED) {
+        fail(filename, string("mmap: ") + strerror(errno));
+    }
+    // Strony są zwalniane razem z ostatnią kopią widoku
+    shared_ptr<const void> mapping(address, [length](const void* p) { munmap(const_cast<void*>(p), length); });
+
+    const char* bytes = static_cast<const char*>(address);
+    BinaryMatrixHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    if (memcmp(header.magic, BINARY_MATRIX_MAGIC, sizeof(header.magic)) != 0) {
+        fail(filename, "brak nagłówka macierzy binarnej");
+    }
+    if (header.version != BINARY_MATRIX_VERSION) {
+        fail(filename, "nieobsługiwana wersja formatu " + to_string(header.version));
+    }
+    if (header.elementType != BinaryElementType::Float64) {
+        fail(filename, "nieobsługiwany typ elementu " + to_string(static_cast<uint32_t>(header.elementType)));
+    }
+    // Rozmiary z nagłówka sprawdzane są dzieleniem, zanim zostaną pomnożone -
+    // uszkodzony nagłówek nie może przepełnić uint64_t i wskazać danych poza plikiem
+    if (header.cities == 0 || header.stride < header.cities || header.stride % DistanceMatrix::lanes != 0
+        || header.payloadOffset % PAYLOAD_ALIGNMENT != 0 || header.payloadOffset > length
+        || header.cities > (length - header.payloadOffset) / sizeof(double) / header.stride
+        || header.namesOffset > length || header.namesSize > length - header.namesOffset) {
+        fail(filename, "niespójny nagłówek macierzy binarnej");
+    }
+    uint64_t payloadBytes = header.cities * header.stride * sizeof(double);
+
+    const double* payload = reinterpret_cast<const double*>(bytes + header.payloadOffset);
+    madvise(const_cast<char*>(bytes) + header.payloadOffset, payloadBytes, MADV_WILLNEED);
+    if (verify && checksum_payload(payload, payloadBytes) != header.checksum) {
+        fail(filename, "niezgodna suma kontrolna macierzy");
+    }
+
+    vector<string> cityNames;
+    const char* name = bytes + header.namesOffset;
+    const char* namesEnd = name + header.namesSize;
+    while (name < namesEnd) {
+        size_t size = strnlen(name, namesEnd - name);
+        cityNames.emplace_back(name, size);
+        name += size + 1;
+    }
+    if (cityNames.size() != header.cities) {
+        fail(filename, "liczba nazw miast różna od rozmiaru macierzy");
+    }
+
+    DistanceMatrix matrix = DistanceMatrix::view(payload, header.cities, header.stride,
+                                                 header.flags & BINARY_MATRIX_SYMMETRIC, move(mapping));
+    return {move(cityNames), move(matrix)};
+}
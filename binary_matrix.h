@@ -0,0 +1,57 @@
+#ifndef BINARY_MATRIX_H
+#define BINARY_MATRIX_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "distance_matrix.h"
+
+using namespace std;
+
+// Binarny format instancji, wczytywany przez mmap bez parsowania. Plik to
+// nagłówek, macierz w układzie DistanceMatrix (wiersze po stride elementów,
+// wyrównane do 64 bajtów) od przesunięcia wyrównanego do strony oraz nazwy miast
+// zakończone bajtem 0. Liczby zapisane są w porządku bajtów maszyny (little-endian).
+// Procesy mapujące ten sam plik współdzielą jedną kopię w pamięci podręcznej stron.
+
+constexpr char BINARY_MATRIX_MAGIC[8] = {'T', 'S', 'P', 'M', 'A', 'T', 'R', 'X'};
+constexpr uint32_t BINARY_MATRIX_VERSION = 1;
+
+// Typ elementu macierzy - DistanceMatrix przechowuje double
+enum class BinaryElementType : uint32_t {
+    Float64 = 1
+};
+
+// Flagi instancji
+constexpr uint32_t BINARY_MATRIX_SYMMETRIC = 1;
+
+struct BinaryMatrixHeader {
+    char magic[8];
+    uint32_t version;
+    BinaryElementType elementType;
+    uint64_t cities;
+    uint64_t stride;         // elementów w wierszu (z dopełnieniem)
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t payloadOffset;  // początek macierzy (wielokrotność rozmiaru strony)
+    uint64_t namesOffset;
+    uint64_t namesSize;
+    uint64_t checksum;       // skrót macierzy (checksum_payload)
+};
+
+// Skrót danych macierzy - 64-bitowe słowa mieszane jak w FNV-1a
+uint64_t checksum_payload(const void* data, size_t bytes);
+
+// Czy plik zaczyna się nagłówkiem formatu binarnego
+bool is_binary_matrix_file(const string& filename);
+
+// Zapisuje instancję w formacie binarnym; zwraca false przy błędzie zapisu
+bool write_binary_matrix(const string& filename, const vector<string>& cityNames, const DistanceMatrix& distanceMatrix);
+
+// Mapuje plik tylko do odczytu i zwraca macierz-widok na zmapowane strony (bez
+// kopiowania). verify == true sprawdza skrót - wymaga odczytu całej macierzy.
+// Niepoprawny plik kończy program.
+pair<vector<string>, DistanceMatrix> map_binary_matrix(const string& filename, bool verify = false);
+
+#endif // BINARY_MATRIX_H
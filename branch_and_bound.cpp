@@ -0,0 +1,518 @@
+#include "tsp.h"
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+const double INF = numeric_limits<double>::infinity();
+
+// Odstęp (w sekundach) między komunikatami o postępie na stderr
+const double PROGRESS_INTERVAL = 1.0;
+
+// Stan krawędzi w węźle drzewa podziału
+enum EdgeState : char { FREE = 0, INCLUDED = 1, EXCLUDED = 2 };
+
+// Węzeł drzewa podziału: stany krawędzi, kary Lagrange'a z najlepszego
+// ograniczenia (start dla potomków) i samo ograniczenie dolne
+struct BbNode {
+    vector<char> edges;
+    vector<double> penalties;
+    double bound;
+};
+
+// Symetryczny problem dla metody podziału i ograniczeń. Instancja niesymetryczna
+// jest przekształcana do symetrycznej o 2n wierzchołkach (Jonker-Volgenant):
+// wierzchołek i oraz jego kopia n + i są połączone krawędzią wymuszoną o koszcie 0,
+// a krawędź (n + i, j) kosztuje d(i, j).
+class SymmetricProblem {
+public:
+    explicit SymmetricProblem(const DistanceMatrix& distanceMatrix)
+        : cities(distanceMatrix.size()), transformed(!distanceMatrix.symmetric()) {
+        size = transformed ? 2 * cities : cities;
+        costs.assign(static_cast<size_t>(size) * size, INF);
+        initialEdges.assign(static_cast<size_t>(size) * size, FREE);
+        integral = true;
+        for (int i = 0; i < cities; ++i) {
+            for (int j = 0; j < cities; ++j) {
+                integral = integral && distanceMatrix(i, j) == floor(distanceMatrix(i, j));
+            }
+        }
+        if (!transformed) {
+            for (int i = 0; i < size; ++i) {
+                for (int j = 0; j < size; ++j) {
+                    costs[index(i, j)] = distanceMatrix(i, j);
+                }
+                initialEdges[index(i, i)] = EXCLUDED;
+            }
+            return;
+        }
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) {
+                initialEdges[index(i, j)] = EXCLUDED;
+            }
+        }
+        for (int i = 0; i < cities; ++i) {
+            costs[index(i, cities + i)] = costs[index(cities + i, i)] = 0.0;
+            initialEdges[index(i, cities + i)] = initialEdges[index(cities + i, i)] = INCLUDED;
+            for (int j = 0; j < cities; ++j) {
+                if (i != j) {
+                    costs[index(cities + i, j)] = costs[index(j, cities + i)] = distanceMatrix(i, j);
+                    initialEdges[index(cities + i, j)] = initialEdges[index(j, cities + i)] = FREE;
+                }
+            }
+        }
+    }
+
+    size_t index(int i, int j) const { return static_cast<size_t>(i) * size + j; }
+    double cost(int i, int j) const { return costs[index(i, j)]; }
+
+    // Odczyt trasy miast z cyklu Hamiltona w grafie symetrycznym (next[v] - sąsiad v)
+    vector<int> decode(const vector<int>& cycle) const {
+        if (!transformed) {
+            return cycle;
+        }
+        // Kierunek obiegu, w którym po wierzchołku i następuje jego kopia n + i
+        vector<int> order(cycle);
+        if (order.size() > 1 && order[1] != cities + order[0] && order[0] < cities) {
+            reverse(order.begin() + 1, order.end());
+        }
+        vector<int> route;
+        for (int v : order) {
+            if (v < cities) {
+                route.push_back(v);
+            }
+        }
+        return route;
+    }
+
+    int cities;
+    int size;
+    bool transformed;
+    bool integral;
+    vector<double> costs;
+    vector<char> initialEdges;
+};
+
+// Wynik obliczenia 1-drzewa dla danych kar
+struct OneTree {
+    double bound = INF;             // koszt 1-drzewa z karami minus 2 * suma kar
+    vector<int> degree;
+    vector<pair<int, int>> edges;
+};
+
+class BranchAndBound {
+public:
+    BranchAndBound(const SymmetricProblem& problem, double upperBound)
+        : problem(problem), n(problem.size), upperBound(upperBound) {}
+
+    // Próg odcięcia: dla kosztów całkowitych wystarczy, by zaokrąglone w górę
+    // ograniczenie dolne nie było lepsze od najlepszego rozwiązania
+    bool prunable(double bound) const {
+        if (problem.integral) {
+            return ceil(bound - 1e-6) >= upperBound - 1e-9;
+        }
+        return bound >= upperBound - 1e-9;
+    }
+
+    void set_edge(vector<char>& edges, int a, int b, EdgeState state) const {
+        edges[problem.index(a, b)] = edges[problem.index(b, a)] = state;
+    }
+
+    // Propagacja ograniczeń stopnia i eliminacja podcykli; false - węzeł sprzeczny
+    bool propagate(vector<char>& edges) const {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int v = 0; v < n; ++v) {
+                int included = 0;
+                int available = 0;
+                for (int u = 0; u < n; ++u) {
+                    char state = edges[problem.index(v, u)];
+                    included += state == INCLUDED;
+                    available += state != EXCLUDED;
+                }
+                if (included > 2 || available < 2) {
+                    return false;
+                }
+                if (included == 2 && available > 2) {
+                    for (int u = 0; u < n; ++u) {
+                        if (edges[problem.index(v, u)] == FREE) {
+                            set_edge(edges, v, u, EXCLUDED);
+                        }
+                    }
+                    changed = true;
+                } else if (available == 2 && included < 2) {
+                    for (int u = 0; u < n; ++u) {
+                        if (edges[problem.index(v, u)] == FREE) {
+                            set_edge(edges, v, u, INCLUDED);
+                        }
+                    }
+                    changed = true;
+                }
+            }
+            if (changed) {
+                continue;
+            }
+            // Ścieżki z krawędzi wymuszonych: krawędź domykająca ścieżkę krótszą
+            // niż cała trasa utworzyłaby podcykl
+            vector<int> first(n, -1), second(n, -1);
+            for (int v = 0; v < n; ++v) {
+                for (int u = 0; u < n; ++u) {
+                    if (edges[problem.index(v, u)] == INCLUDED) {
+                        (first[v] < 0 ? first[v] : second[v]) = u;
+                    }
+                }
+            }
+            auto next_on_path = [&](int current, int previous) {
+                return first[current] != previous ? first[current] : second[current];
+            };
+            vector<char> visited(n, 0);
+            for (int start = 0; start < n; ++start) {
+                if (visited[start] || first[start] < 0 || second[start] >= 0) {
+                    continue;
+                }
+                // start jest końcem ścieżki - idziemy do drugiego końca
+                int previous = -1;
+                int current = start;
+                int length = 1;
+                visited[start] = 1;
+                for (int next = next_on_path(current, previous); next >= 0; next = next_on_path(current, previous)) {
+                    previous = current;
+                    current = next;
+                    visited[current] = 1;
+                    ++length;
+                }
+                if (length < n && edges[problem.index(start, current)] == FREE) {
+                    set_edge(edges, start, current, EXCLUDED);
+                    changed = true;
+                }
+            }
+            // Nieodwiedzone wierzchołki z dwiema krawędziami wymuszonymi leżą na cyklu
+            for (int v = 0; v < n; ++v) {
+                if (visited[v] || second[v] < 0) {
+                    continue;
+                }
+                int previous = -1;
+                int current = v;
+                int length = 0;
+                do {
+                    visited[current] = 1;
+                    int next = next_on_path(current, previous);
+                    previous = current;
+                    current = next;
+                    ++length;
+                } while (current != v);
+                if (length < n) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Minimalne 1-drzewo: drzewo rozpinające na wierzchołkach 1..n-1 (Prim)
+    // i dwie najtańsze krawędzie wierzchołka 0, z uwzględnieniem stanów krawędzi
+    OneTree one_tree(const vector<char>& edges, const vector<double>& penalties) const {
+        const double FORCED = 1e12;
+        OneTree tree;
+        tree.degree.assign(n, 0);
+        auto weight = [&](int a, int b) { return problem.cost(a, b) + penalties[a] + penalties[b]; };
+
+        vector<double> key(n, INF);
+        vector<int> parent(n, -1);
+        vector<char> inTree(n, 0);
+        double total = 0.0;
+        key[1] = 0.0;
+        for (int step = 1; step < n; ++step) {
+            int v = -1;
+            for (int u = 1; u < n; ++u) {
+                if (!inTree[u] && (v < 0 || key[u] < key[v])) {
+                    v = u;
+                }
+            }
+            if (key[v] == INF) {
+                return tree; // graf bez krawędzi zabronionych jest niespójny
+            }
+            inTree[v] = 1;
+            if (parent[v] >= 0) {
+                total += weight(v, parent[v]);
+                tree.edges.push_back({v, parent[v]});
+                ++tree.degree[v];
+                ++tree.degree[parent[v]];
+            }
+            for (int u = 1; u < n; ++u) {
+                char state = edges[problem.index(v, u)];
+                if (inTree[u] || state == EXCLUDED) {
+                    continue;
+                }
+                double w = weight(v, u) - (state == INCLUDED ? FORCED : 0.0);
+                if (w < key[u]) {
+                    key[u] = w;
+                    parent[u] = v;
+                }
+            }
+        }
+
+        // Wierzchołek 0: najpierw krawędzie wymuszone, potem najtańsze wolne
+        vector<int> chosen;
+        for (int u = 1; u < n; ++u) {
+            if (edges[problem.index(0, u)] == INCLUDED) {
+                chosen.push_back(u);
+            }
+        }
+        while (chosen.size() < 2) {
+            int best = -1;
+            for (int u = 1; u < n; ++u) {
+                if (edges[problem.index(0, u)] == FREE && find(chosen.begin(), chosen.end(), u) == chosen.end()
+                    && (best < 0 || weight(0, u) < weight(0, best))) {
+                    best = u;
+                }
+            }
+            if (best < 0) {
+                return tree;
+            }
+            chosen.push_back(best);
+        }
+        for (int u : chosen) {
+            total += weight(0, u);
+            tree.edges.push_back({0, u});
+            ++tree.degree[0];
+            ++tree.degree[u];
+        }
+
+        double penaltySum = 0.0;
+        for (double p : penalties) {
+            penaltySum += p;
+        }
+        tree.bound = total - 2.0 * penaltySum;
+        return tree;
+    }
+
+    // Optymalizacja subgradientowa kar Lagrange'a (ograniczenie Helda-Karpa).
+    // Uzupełnia node.bound i node.penalties; zwraca najlepsze 1-drzewo.
+    OneTree lower_bound(BbNode& node, int iterations) {
+        vector<double> penalties = node.penalties;
+        OneTree best;
+        best.bound = -INF;
+        double lambda = 2.0;
+        int sinceImprovement = 0;
+        for (int it = 0; it < iterations; ++it) {
+            OneTree tree = one_tree(node.edges, penalties);
+            if (tree.bound == INF) {
+                node.bound = INF;
+                return tree;
+            }
+            if (tree.bound > best.bound + 1e-9) {
+                best = tree;
+                node.penalties = penalties;
+                sinceImprovement = 0;
+            } else if (++sinceImprovement >= 5) {
+                lambda /= 2.0;
+                sinceImprovement = 0;
+            }
+
+            double norm = 0.0;
+            for (int d : tree.degree) {
+                norm += (d - 2) * (d - 2);
+            }
+            if (norm == 0.0) {
+                // 1-drzewo jest cyklem Hamiltona - ograniczenie osiągnięte
+                best = tree;
+                node.penalties = penalties;
+                break;
+            }
+            if (prunable(best.bound) || lambda < 1e-4) {
+                break;
+            }
+            double target = isfinite(upperBound) ? upperBound : best.bound + fabs(best.bound) * 0.1 + 1.0;
+            double stepSize = lambda * (target - tree.bound) / norm;
+            for (int v = 0; v < n; ++v) {
+                penalties[v] += stepSize * (tree.degree[v] - 2);
+            }
+        }
+        node.bound = best.bound;
+        return best;
+    }
+
+    // Cykl (kolejność wierzchołków) z 1-drzewa o wszystkich stopniach równych 2
+    vector<int> tree_cycle(const OneTree& tree) const {
+        vector<vector<int>> adjacent(n);
+        for (auto [a, b] : tree.edges) {
+            adjacent[a].push_back(b);
+            adjacent[b].push_back(a);
+        }
+        vector<int> cycle{0};
+        int previous = -1;
+        int current = 0;
+        for (int k = 1; k < n; ++k) {
+            int next = adjacent[current][0] != previous ? adjacent[current][0] : adjacent[current][1];
+            previous = current;
+            current = next;
+            cycle.push_back(current);
+        }
+        return cycle;
+    }
+
+    const SymmetricProblem& problem;
+    int n;
+    double upperBound;
+};
+
+} // namespace
+
+// Metoda podziału i ograniczeń z ograniczeniem dolnym Helda-Karpa (1-drzewa
+// z karami Lagrange'a optymalizowanymi subgradientowo). Podział po krawędzi
+// 1-drzewa przy wierzchołku stopnia > 2: potomek "krawędź wykluczona"
+// i "krawędź wymuszona". Przeszukiwanie w głąb, ograniczenie górne z Lina-Kernighana.
+// Kończy pracę po udowodnieniu optymalności lub po upływie timeLimitSeconds;
+// gap to względna luka (UB - LB) / UB w chwili zakończenia.
+Route solve_branch_and_bound(const DistanceMatrix& distanceMatrix, double timeLimitSeconds, int& iteration_count, double& gap) {
+    auto start = chrono::steady_clock::now();
+    auto elapsed = [&]() { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); };
+    int numberOfCities = distanceMatrix.size();
+    iteration_count = 0;
+    gap = 0.0;
+
+    int heuristicIterations;
+    Route bestRoute = solve_lin_kernighan(distanceMatrix, numeric_limits<int>::max(), heuristicIterations);
+    if (!distanceMatrix.symmetric()) {
+        // LK działa na średnich kosztach - dla instancji niesymetrycznej dokładamy
+        // przeszukiwanie Or-opt, które zachowuje kierunek obiegu
+        Route orOptRoute = solve_hill_climbing(distanceMatrix, numeric_limits<int>::max(), heuristicIterations,
+                                               ImprovementStrategy::First, NeighborhoodType::OrOpt, 10);
+        if (orOptRoute.cost < bestRoute.cost) {
+            bestRoute = orOptRoute;
+        }
+    }
+    if (numberOfCities <= 3) {
+        return bestRoute;
+    }
+
+    SymmetricProblem problem(distanceMatrix);
+    BranchAndBound bb(problem, bestRoute.cost);
+
+    // Ślady ograniczenia górnego, dolnego (rośnie - Maximize) i luki
+    Trace upperBoundTrace("branch_and_bound");
+    Trace lowerBoundTrace("branch_and_bound_lower_bound", TraceDirection::Maximize);
+    Trace gapTrace("branch_and_bound_gap");
+
+    BbNode root{problem.initialEdges, vector<double>(problem.size, 0.0), -INF};
+    if (!bb.propagate(root.edges)) {
+        return bestRoute;
+    }
+
+    // Bieżąca luka trafia do śladów, a co PROGRESS_INTERVAL sekund także na
+    // stderr - postęp jest widoczny bez włączania śladów
+    double nextProgress = PROGRESS_INTERVAL;
+    auto report = [&](double lowerBound) {
+        gap = bb.upperBound > 0 ? max(0.0, (bb.upperBound - lowerBound) / bb.upperBound) : 0.0;
+        upperBoundTrace.record(iteration_count, bb.upperBound);
+        lowerBoundTrace.record(iteration_count, lowerBound);
+        gapTrace.record(iteration_count, gap);
+        if (elapsed() >= nextProgress) {
+            nextProgress += PROGRESS_INTERVAL;
+            cerr << "Podział i ograniczenia: iteracja " << iteration_count << ", UB " << bb.upperBound << ", LB "
+                 << lowerBound << ", luka " << gap * 100.0 << " %" << endl;
+        }
+    };
+
+    // Ocena węzła: ograniczenie dolne, ewentualnie nowe rozwiązanie
+    auto evaluate = [&](BbNode& node, int iterations) -> OneTree {
+        OneTree tree = bb.lower_bound(node, iterations);
+        if (node.bound < INF && all_of(tree.degree.begin(), tree.degree.end(), [](int d) { return d == 2; })) {
+            vector<int> cities = problem.decode(bb.tree_cycle(tree));
+            double cost = check_cost(cities, distanceMatrix);
+            if (cost < bb.upperBound - 1e-9) {
+                bb.upperBound = cost;
+                bestRoute = {cities, cost};
+            }
+        }
+        return tree;
+    };
+
+    evaluate(root, 50 * problem.size);
+    report(root.bound);
+
+    vector<BbNode> stack;
+    if (!bb.prunable(root.bound)) {
+        stack.push_back(move(root));
+    }
+    bool timeUp = false;
+    while (!stack.empty()) {
+        if (elapsed() > timeLimitSeconds) {
+            timeUp = true;
+            break;
+        }
+        BbNode node = move(stack.back());
+        stack.pop_back();
+        if (bb.prunable(node.bound)) {
+            continue;
+        }
+        iteration_count++;
+
+        // Ograniczenie węzła policzono przy jego tworzeniu - odtwarzamy tylko 1-drzewo
+        OneTree tree = bb.one_tree(node.edges, node.penalties);
+        if (tree.bound == INF || all_of(tree.degree.begin(), tree.degree.end(), [](int d) { return d == 2; })) {
+            continue;
+        }
+
+        // Krawędź podziału: najdroższa wolna krawędź 1-drzewa przy wierzchołku
+        // o największym stopniu
+        int hub = max_element(tree.degree.begin(), tree.degree.end()) - tree.degree.begin();
+        int other = -1;
+        for (auto [a, b] : tree.edges) {
+            int u = a == hub ? b : (b == hub ? a : -1);
+            if (u >= 0 && node.edges[problem.index(hub, u)] == FREE
+                && (other < 0 || problem.cost(hub, u) > problem.cost(hub, other))) {
+                other = u;
+            }
+        }
+        if (other < 0) {
+            continue;
+        }
+
+        BbNode children[2] = {node, node};
+        bb.set_edge(children[0].edges, hub, other, EXCLUDED);
+        bb.set_edge(children[1].edges, hub, other, INCLUDED);
+        for (BbNode& child : children) {
+            if (bb.propagate(child.edges)) {
+                evaluate(child, 20);
+            } else {
+                child.bound = INF;
+            }
+        }
+        // Najpierw potomek z lepszym ograniczeniem (trafia na wierzch stosu)
+        if (children[0].bound < children[1].bound) {
+            swap(children[0], children[1]);
+        }
+        for (BbNode& child : children) {
+            if (!bb.prunable(child.bound)) {
+                stack.push_back(move(child));
+            }
+        }
+
+        if (iteration_count % 256 == 0 || elapsed() >= nextProgress) {
+            double lowerBound = bb.upperBound;
+            for (const BbNode& open : stack) {
+                lowerBound = min(lowerBound, open.bound);
+            }
+            report(lowerBound);
+        }
+    }
+
+    double lowerBound = bb.upperBound;
+    if (timeUp) {
+        for (const BbNode& open : stack) {
+            lowerBound = min(lowerBound, open.bound);
+        }
+    }
+    report(lowerBound);
+    return bestRoute;
+}
@@ -0,0 +1,40 @@
+#include "candidate_list.h"
+#include "coordinate_distances.h"
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+template <typename Distances>
+CandidateList::CandidateList(const Distances& distances, int k)
+    : cityCount(distances.size()), perCity(max(0, min(k, static_cast<int>(distances.size()) - 1))) {
+    neighbors.resize(static_cast<size_t>(cityCount) * perCity);
+    // Bliskość miasta a do wszystkich miast - wiersz liczony blokiem przez dostawcę
+    vector<double> closeness(cityCount);
+    vector<int> order;
+    for (int a = 0; a < cityCount; ++a) {
+        distances.distances_from(a, 0, cityCount, closeness.data());
+        if (!distances.symmetric()) {
+            for (int b = 0; b < cityCount; ++b) {
+                closeness[b] = 0.5 * (closeness[b] + distances(b, a));
+            }
+        }
+        order.resize(cityCount);
+        iota(order.begin(), order.end(), 0);
+        order.erase(order.begin() + a);
+        // Wybór k najbliższych w O(n), sortowanie tylko wybranych
+        auto closer = [&](int x, int y) { return closeness[x] < closeness[y]; };
+        nth_element(order.begin(), order.begin() + perCity, order.end(), closer);
+        sort(order.begin(), order.begin() + perCity, closer);
+        copy(order.begin(), order.begin() + perCity, neighbors.begin() + static_cast<size_t>(a) * perCity);
+    }
+}
+
+template CandidateList::CandidateList(const DistanceMatrix&, int);
+template CandidateList::CandidateList(const EuclideanDistances&, int);
+template CandidateList::CandidateList(const HaversineDistances&, int);
+
+bool CandidateList::contains(int city, int candidate) const {
+    const int* list = of(city);
+    return find(list, list + perCity, candidate) != list + perCity;
+}
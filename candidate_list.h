@@ -0,0 +1,35 @@
+#ifndef CANDIDATE_LIST_H
+#define CANDIDATE_LIST_H
+
+#include <vector>
+#include "distance_matrix.h"
+
+using namespace std;
+
+// Listy kandydatów: dla każdego miasta k najbliższych miast, posortowanych
+// rosnąco według odległości i zapisanych w jednej tablicy (wiersz na miasto).
+// Dla macierzy niesymetrycznej miarą bliskości jest średnia z obu kierunków.
+// Konstruktor jest szablonowy względem dostawcy odległości (DistanceMatrix,
+// EuclideanDistances, HaversineDistances) - instancje w candidate_list.cpp.
+class CandidateList {
+public:
+    CandidateList() = default;
+    template <typename Distances>
+    CandidateList(const Distances& distances, int k);
+
+    int cities() const { return cityCount; }
+
+    // Liczba kandydatów na miasto
+    int k() const { return perCity; }
+
+    const int* of(int city) const { return neighbors.data() + static_cast<size_t>(city) * perCity; }
+
+    bool contains(int city, int candidate) const;
+
+private:
+    int cityCount = 0;
+    int perCity = 0;
+    vector<int> neighbors;
+};
+
+#endif // CANDIDATE_LIST_H
@@ -0,0 +1,93 @@
+#include "coordinate_distances.h"
+#include <algorithm>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+// Pierwiastek sumy kwadratów różnic współrzędnych: out[t] = |p - q_t| dla
+// q_t = (a[t], b[t], c[t]); c == nullptr oznacza punkty na płaszczyźnie.
+// Jądro wektorowe (AVX2 - 4 pary, SSE2 - 2 pary na instrukcję) z resztą skalarną.
+void norms(double pa, double pb, double pc, const double* a, const double* b, const double* c, size_t count,
+           double* out) {
+    size_t t = 0;
+#if defined(__AVX2__)
+    __m256d va = _mm256_set1_pd(pa);
+    __m256d vb = _mm256_set1_pd(pb);
+    __m256d vc = _mm256_set1_pd(pc);
+    for (; t + 4 <= count; t += 4) {
+        __m256d da = _mm256_sub_pd(va, _mm256_loadu_pd(a + t));
+        __m256d db = _mm256_sub_pd(vb, _mm256_loadu_pd(b + t));
+        __m256d sum = _mm256_add_pd(_mm256_mul_pd(da, da), _mm256_mul_pd(db, db));
+        if (c) {
+            __m256d dc = _mm256_sub_pd(vc, _mm256_loadu_pd(c + t));
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(dc, dc));
+        }
+        _mm256_storeu_pd(out + t, _mm256_sqrt_pd(sum));
+    }
+#elif defined(__SSE2__)
+    __m128d va = _mm_set1_pd(pa);
+    __m128d vb = _mm_set1_pd(pb);
+    __m128d vc = _mm_set1_pd(pc);
+    for (; t + 2 <= count; t += 2) {
+        __m128d da = _mm_sub_pd(va, _mm_loadu_pd(a + t));
+        __m128d db = _mm_sub_pd(vb, _mm_loadu_pd(b + t));
+        __m128d sum = _mm_add_pd(_mm_mul_pd(da, da), _mm_mul_pd(db, db));
+        if (c) {
+            __m128d dc = _mm_sub_pd(vc, _mm_loadu_pd(c + t));
+            sum = _mm_add_pd(sum, _mm_mul_pd(dc, dc));
+        }
+        _mm_storeu_pd(out + t, _mm_sqrt_pd(sum));
+    }
+#endif
+    for (; t < count; ++t) {
+        double da = pa - a[t];
+        double db = pb - b[t];
+        double sum = da * da + db * db;
+        if (c) {
+            double dc = pc - c[t];
+            sum += dc * dc;
+        }
+        out[t] = sqrt(sum);
+    }
+}
+
+} // namespace
+
+void EuclideanDistances::distances_from(size_t city, size_t first, size_t count, double* out) const {
+    norms(x[city], y[city], 0.0, x.data() + first, y.data() + first, nullptr, count, out);
+    if (rounding != DistanceRounding::None) {
+        for (size_t t = 0; t < count; ++t) {
+            out[t] = round_distance(out[t], rounding);
+        }
+    }
+}
+
+HaversineDistances::HaversineDistances(const vector<double>& latitude, const vector<double>& longitude, double radius,
+                                       DistanceRounding rounding)
+    : px(latitude.size()), py(latitude.size()), pz(latitude.size()), radius(radius), rounding(rounding) {
+    const double toRadians = M_PI / 180.0;
+    for (size_t i = 0; i < latitude.size(); ++i) {
+        double phi = latitude[i] * toRadians;
+        double lambda = longitude[i] * toRadians;
+        px[i] = cos(phi) * cos(lambda);
+        py[i] = cos(phi) * sin(lambda);
+        pz[i] = sin(phi);
+    }
+}
+
+// Cięciwy liczone wektorowo, asin - skalarnie
+void HaversineDistances::distances_from(size_t city, size_t first, size_t count, double* out) const {
+    norms(px[city], py[city], pz[city], px.data() + first, py.data() + first, pz.data() + first, count, out);
+    for (size_t t = 0; t < count; ++t) {
+        out[t] = round_distance(arc(out[t]), rounding);
+    }
+    if (city >= first && city < first + count) {
+        out[city - first] = 0.0;
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef COORDINATE_DISTANCES_H
+#define COORDINATE_DISTANCES_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// Dostawcy odległości liczonych na żądanie ze współrzędnych - zamiast macierzy
+// n x n (100 tys. miast to 80 GB) przechowują O(n) liczb. Mają ten sam interfejs
+// co DistanceMatrix, na którym szablonowe są algorytmy z tsp.cpp:
+//   size(), symmetric(), operator()(i, j) oraz
+//   distances_from(city, first, count, out) - odległości z miasta city do miast
+//   first .. first + count - 1 (jądro wektorowe dla całych bloków miast).
+
+// Zaokrąglanie odległości (zgodne z typami TSPLIB)
+enum class DistanceRounding {
+    None,
+    Nearest,  // EUC_2D
+    Up,       // CEIL_2D
+    Geo       // GEO: int(d + 1)
+};
+
+inline double round_distance(double distance, DistanceRounding rounding) {
+    switch (rounding) {
+    case DistanceRounding::Nearest:
+        return floor(distance + 0.5);
+    case DistanceRounding::Up:
+        return ceil(distance);
+    case DistanceRounding::Geo:
+        return floor(distance + 1.0);
+    case DistanceRounding::None:
+        break;
+    }
+    return distance;
+}
+
+// Odległość euklidesowa na płaszczyźnie
+class EuclideanDistances {
+public:
+    EuclideanDistances() = default;
+    EuclideanDistances(vector<double> x, vector<double> y, DistanceRounding rounding = DistanceRounding::None)
+        : x(move(x)), y(move(y)), rounding(rounding) {}
+
+    size_t size() const { return x.size(); }
+
+    bool symmetric() const { return true; }
+
+    double operator()(size_t i, size_t j) const {
+        double dx = x[i] - x[j];
+        double dy = y[i] - y[j];
+        return round_distance(sqrt(dx * dx + dy * dy), rounding);
+    }
+
+    void distances_from(size_t city, size_t first, size_t count, double* out) const;
+
+private:
+    vector<double> x;
+    vector<double> y;
+    DistanceRounding rounding = DistanceRounding::None;
+};
+
+// Odległość po okręgu wielkim (wzór haversine) dla szerokości i długości
+// geograficznej w stopniach. Miasta zapamiętane są jako punkty na sferze
+// jednostkowej: odległość to 2R·asin(c / 2), gdzie c to długość cięciwy -
+// tożsamościowo równe wzorowi haversine, ale bez funkcji trygonometrycznych
+// poza jednym asin na parę. Zaokrąglenie Geo daje odległości typu TSPLIB GEO
+// (d(i, i) pozostaje 0); None - rzeczywiste odległości dla własnych danych.
+class HaversineDistances {
+public:
+    // Średni promień Ziemi w kilometrach
+    static constexpr double EARTH_RADIUS = 6371.0;
+
+    HaversineDistances() = default;
+    HaversineDistances(const vector<double>& latitude, const vector<double>& longitude, double radius = EARTH_RADIUS,
+                       DistanceRounding rounding = DistanceRounding::None);
+
+    size_t size() const { return px.size(); }
+
+    bool symmetric() const { return true; }
+
+    double operator()(size_t i, size_t j) const {
+        double dx = px[i] - px[j];
+        double dy = py[i] - py[j];
+        double dz = pz[i] - pz[j];
+        return i == j ? 0.0 : round_distance(arc(sqrt(dx * dx + dy * dy + dz * dz)), rounding);
+    }
+
+    void distances_from(size_t city, size_t first, size_t count, double* out) const;
+
+private:
+    double arc(double chord) const { return 2.0 * radius * asin(min(1.0, 0.5 * chord)); }
+
+    vector<double> px;
+    vector<double> py;
+    vector<double> pz;
+    double radius = EARTH_RADIUS;
+    DistanceRounding rounding = DistanceRounding::None;
+};
+
+#endif // COORDINATE_DISTANCES_H
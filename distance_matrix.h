@@ -0,0 +1,169 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+using namespace std;
+
+// Macierz odległości przechowywana w jednym, wyrównanym buforze (wierszami).
+// Długość wiersza (stride) jest dopełniona do wielokrotności 64 bajtów, więc
+// każdy wiersz zaczyna się na granicy linii pamięci podręcznej i rejestru SIMD.
+// Elementy dopełnienia mają wartość 0.
+// Flaga symetrii jest domyślnie wyłączona (bezpieczne założenie dla ruchów
+// odwracających fragment trasy) - ustawia ją update_symmetry().
+// Macierz może też być widokiem (view) na cudzy bufor o tym samym układzie,
+// np. plik zmapowany w pamięci - bez kopiowania danych. Bufor widoku jest tylko
+// do odczytu: dostęp przez metody const go czyta, a pierwszy dostęp do zapisu
+// (nie-const operator(), row, operator[], data) kopiuje dane do własnego bufora
+// (copy-on-write). Kopia widoku jest zwykłą macierzą z własnym buforem.
+template <typename T>
+class BasicDistanceMatrix {
+public:
+    using value_type = T;
+
+    static constexpr size_t alignment = 64;
+    static constexpr size_t lanes = alignment / sizeof(T);
+
+    BasicDistanceMatrix() = default;
+
+    explicit BasicDistanceMatrix(size_t n, T value = T())
+        : cityCount(n), rowStride(padded_stride(n)), values(allocate(n * padded_stride(n))), base(values.get()) {
+        fill(values.get(), values.get() + cityCount * rowStride, T());
+        for (size_t i = 0; i < n; ++i) {
+            fill(row(i), row(i) + n, value);
+        }
+    }
+
+    BasicDistanceMatrix(const BasicDistanceMatrix& other)
+        : cityCount(other.cityCount), rowStride(other.rowStride), values(allocate(other.cityCount * other.rowStride)),
+          base(values.get()), symmetricFlag(other.symmetricFlag) {
+        copy(other.data(), other.data() + cityCount * rowStride, values.get());
+    }
+
+    // Widok na bufor data (n wierszy po stride elementów, wiersze wyrównane do
+    // 64 bajtów). owner utrzymuje bufor przy życiu tak długo, jak widok.
+    static BasicDistanceMatrix view(const T* data, size_t n, size_t stride, bool symmetric,
+                                    shared_ptr<const void> owner) {
+        BasicDistanceMatrix matrix;
+        matrix.cityCount = n;
+        matrix.rowStride = stride;
+        matrix.base = data;
+        matrix.symmetricFlag = symmetric;
+        matrix.owner = move(owner);
+        return matrix;
+    }
+
+    // Czy macierz jest widokiem na cudzy bufor
+    bool is_view() const { return base && !values; }
+
+    BasicDistanceMatrix& operator=(const BasicDistanceMatrix& other) {
+        if (this != &other) {
+            BasicDistanceMatrix tmp(other);
+            swap(*this, tmp);
+        }
+        return *this;
+    }
+
+    // Przeniesienie zostawia pustą macierz (base nie może wskazywać przeniesionego bufora)
+    BasicDistanceMatrix(BasicDistanceMatrix&& other) noexcept { swap(*this, other); }
+
+    BasicDistanceMatrix& operator=(BasicDistanceMatrix&& other) noexcept {
+        BasicDistanceMatrix tmp(move(other));
+        swap(*this, tmp);
+        return *this;
+    }
+
+    friend void swap(BasicDistanceMatrix& lhs, BasicDistanceMatrix& rhs) noexcept {
+        using std::swap;
+        swap(lhs.cityCount, rhs.cityCount);
+        swap(lhs.rowStride, rhs.rowStride);
+        swap(lhs.values, rhs.values);
+        swap(lhs.base, rhs.base);
+        swap(lhs.owner, rhs.owner);
+        swap(lhs.symmetricFlag, rhs.symmetricFlag);
+    }
+
+    // Liczba miast
+    size_t size() const { return cityCount; }
+
+    bool empty() const { return cityCount == 0; }
+
+    // Odstęp (w elementach) między początkami kolejnych wierszy
+    size_t stride() const { return rowStride; }
+
+    T operator()(size_t i, size_t j) const { return base[i * rowStride + j]; }
+    T& operator()(size_t i, size_t j) { return writable()[i * rowStride + j]; }
+
+    const T* row(size_t i) const { return base + i * rowStride; }
+    T* row(size_t i) { return writable() + i * rowStride; }
+
+    const T* operator[](size_t i) const { return row(i); }
+    T* operator[](size_t i) { return row(i); }
+
+    const T* data() const { return base; }
+    T* data() { return writable(); }
+
+    // Odległości z miasta city do miast first .. first + count - 1 (interfejs
+    // wspólny z dostawcami odległości liczonych ze współrzędnych)
+    void distances_from(size_t city, size_t first, size_t count, T* out) const {
+        copy(row(city) + first, row(city) + first + count, out);
+    }
+
+    // Czy d(i, j) == d(j, i) dla wszystkich par (stan z ostatniego update_symmetry)
+    bool symmetric() const { return symmetricFlag; }
+
+    bool update_symmetry() {
+        symmetricFlag = true;
+        const BasicDistanceMatrix& self = *this;  // odczyt nie kopiuje widoku
+        for (size_t i = 0; i < cityCount && symmetricFlag; ++i) {
+            for (size_t j = i + 1; j < cityCount; ++j) {
+                if (self(i, j) != self(j, i)) {
+                    symmetricFlag = false;
+                    break;
+                }
+            }
+        }
+        return symmetricFlag;
+    }
+
+    static size_t padded_stride(size_t n) { return (n + lanes - 1) / lanes * lanes; }
+
+private:
+    struct AlignedDelete {
+        void operator()(T* p) const { ::operator delete[](p, align_val_t(alignment)); }
+    };
+
+    // Bufor do zapisu - widok najpierw zamieniany jest na kopię danych
+    T* writable() {
+        if (!values && base) {
+            values = allocate(cityCount * rowStride);
+            copy(base, base + cityCount * rowStride, values.get());
+            base = values.get();
+            owner.reset();
+        }
+        return values.get();
+    }
+
+    static unique_ptr<T[], AlignedDelete> allocate(size_t count) {
+        if (count == 0) {
+            return nullptr;
+        }
+        return unique_ptr<T[], AlignedDelete>(static_cast<T*>(::operator new[](count * sizeof(T), align_val_t(alignment))));
+    }
+
+    size_t cityCount = 0;
+    size_t rowStride = 0;
+    unique_ptr<T[], AlignedDelete> values;
+    // Początek danych: values.get() albo bufor widoku
+    const T* base = nullptr;
+    shared_ptr<const void> owner;
+    bool symmetricFlag = false;
+};
+
+using DistanceMatrix = BasicDistanceMatrix<double>;
+
+#endif // DISTANCE_MATRIX_H
@@ -0,0 +1,40 @@
+#ifndef DONT_LOOK_BITS_H
+#define DONT_LOOK_BITS_H
+
+#include <deque>
+#include <vector>
+
+using namespace std;
+
+// Bity "nie patrz" (don't-look bits): kolejka FIFO aktywnych miast. Miasto,
+// dla którego nie znaleziono poprawiającego ruchu, wypada z kolejki i wraca
+// do niej dopiero, gdy zmieni się któraś z jego krawędzi w trasie.
+class DontLookBits {
+public:
+    explicit DontLookBits(int numberOfCities) : active(numberOfCities, 0) {}
+
+    void activate(int city) {
+        if (!active[city]) {
+            active[city] = 1;
+            queue.push_back(city);
+        }
+    }
+
+    bool empty() const { return queue.empty(); }
+
+    // Liczba aktywnych miast
+    size_t size() const { return queue.size(); }
+
+    int pop() {
+        int city = queue.front();
+        queue.pop_front();
+        active[city] = 0;
+        return city;
+    }
+
+private:
+    vector<char> active;
+    deque<int> queue;
+};
+
+#endif // DONT_LOOK_BITS_H
@@ -0,0 +1,219 @@
+#include "tsp.h"
+#include "shared_best.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Co tyle węzłów przeszukiwania wątek dopisuje swój licznik do licznika wspólnego
+const int ITERATION_BATCH = 256;
+
+// Wspólne dane przeszukiwania: sąsiedzi każdego miasta rosnąco po odległości
+// i najtańsza krawędź wychodząca z każdego miasta
+struct SearchData {
+    const DistanceMatrix& distanceMatrix;
+    vector<vector<int>> nearest;
+    vector<double> minOut;
+    bool skipReflections;
+    long long maxIterations;
+    SharedBest& shared;
+    atomic<long long>& iterations;
+};
+
+// Przeszukiwanie w głąb poddrzewa jednego prefiksu (0, a, b) z kosztem prefiksu
+// liczonym przyrostowo. Ograniczenie dolne gałęzi: koszt prefiksu plus
+// najtańsze krawędzie wychodzące z ostatniego miasta i ze wszystkich
+// nieodwiedzonych - każde z nich musi jeszcze wypuścić jedną krawędź trasy.
+class PrefixSearch {
+public:
+    explicit PrefixSearch(SearchData& data) : data(data) {}
+
+    // false - wyczerpano limit iteracji
+    bool run(int a, int b) {
+        const DistanceMatrix& dm = data.distanceMatrix;
+        int n = dm.size();
+        second = a;
+        uint32_t unvisited = 0;
+        double remainingMinOut = 0.0;
+        for (int city = 1; city < n; ++city) {
+            if (city != a && city != b) {
+                unvisited |= 1u << city;
+                remainingMinOut += data.minOut[city];
+            }
+        }
+        path = {0, a, b};
+        double cost = dm(0, a) + dm(a, b);
+        if (cost + data.minOut[b] + remainingMinOut < data.shared.cost()) {
+            search(b, unvisited, cost, remainingMinOut);
+        }
+        return !stopped;
+    }
+
+    // Dopisuje niezliczone jeszcze iteracje do licznika wspólnego
+    void flush() {
+        data.iterations += pending;
+        pending = 0;
+    }
+
+private:
+    void search(int last, uint32_t unvisited, double cost, double remainingMinOut) {
+        const DistanceMatrix& dm = data.distanceMatrix;
+        if (++pending + data.iterations.load(memory_order_relaxed) >= data.maxIterations) {
+            stopped = true;
+        }
+        if (pending == ITERATION_BATCH) {
+            flush();
+        }
+        if (stopped) {
+            return;
+        }
+        if (unvisited == 0) {
+            double total = cost + dm(last, 0);
+            data.shared.offer(path, total, data.iterations + pending);
+            return;
+        }
+        // Sąsiedzi posortowani rosnąco - ograniczenie rośnie razem z kosztem
+        // krawędzi, więc pierwsze odcięcie kończy pętlę
+        for (int next : data.nearest[last]) {
+            uint32_t bit = 1u << next;
+            if (!(unvisited & bit)) {
+                continue;
+            }
+            uint32_t rest = unvisited & ~bit;
+            if (data.skipReflections && rest == 0 && next < second) {
+                continue;
+            }
+            double nextCost = cost + dm(last, next);
+            if (nextCost + remainingMinOut >= data.shared.cost()) {
+                break;
+            }
+            path.push_back(next);
+            search(next, rest, nextCost, remainingMinOut - data.minOut[next]);
+            path.pop_back();
+            if (stopped) {
+                return;
+            }
+        }
+    }
+
+    SearchData& data;
+    vector<int> path;
+    int second = 0;
+    long long pending = 0;
+    bool stopped = false;
+};
+
+// Trasa najbliższego sąsiada z miasta 0 - początkowe ograniczenie górne
+Route nearest_neighbor_route(const vector<vector<int>>& nearest, const DistanceMatrix& distanceMatrix) {
+    int n = distanceMatrix.size();
+    vector<char> visited(n, 0);
+    vector<int> cities{0};
+    visited[0] = 1;
+    while (static_cast<int>(cities.size()) < n) {
+        for (int next : nearest[cities.back()]) {
+            if (!visited[next]) {
+                visited[next] = 1;
+                cities.push_back(next);
+                break;
+            }
+        }
+    }
+    return {cities, check_cost(cities, distanceMatrix)};
+}
+
+} // namespace
+
+// Pełny przegląd z miastem 0 ustalonym na początku trasy (obroty cyklu są
+// równoważne), realizowany jako przeszukiwanie w głąb z odcinaniem gałęzi,
+// których ograniczenie dolne nie jest lepsze od najlepszej znanej trasy.
+// Przestrzeń tras dzielona jest na prefiksy (0, a, b), które wątki pobierają
+// ze wspólnej kolejki (od najtańszych); najlepsza trasa jest wspólna. Dla
+// macierzy symetrycznej pomijane są odbicia - zostają tylko trasy, w których
+// drugie miasto ma mniejszy numer niż ostatnie. Iteracja to odwiedzony węzeł
+// drzewa przeszukiwania; maxIterations ogranicza ich łączną liczbę (przy wielu
+// wątkach z dokładnością do paczek, w których zliczają iteracje).
+Route solve_full_review(const DistanceMatrix& distanceMatrix, int maxIterations, int& iteration_count, int threads) {
+    int numberOfCities = distanceMatrix.size();
+    vector<int> identity(numberOfCities);
+    iota(identity.begin(), identity.end(), 0);
+    iteration_count = 0;
+    if (numberOfCities <= 2) {
+        return {identity, numberOfCities > 0 ? check_cost(identity, distanceMatrix) : 0.0};
+    }
+    if (numberOfCities > FULL_REVIEW_MAX_CITIES) {
+        cerr << "Pełny przegląd: zbyt wiele miast (" << numberOfCities << " > " << FULL_REVIEW_MAX_CITIES << ")" << endl;
+        return {{}, numeric_limits<double>::infinity()};
+    }
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+
+    vector<vector<int>> nearest(numberOfCities);
+    vector<double> minOut(numberOfCities, numeric_limits<double>::infinity());
+    for (int i = 0; i < numberOfCities; ++i) {
+        for (int j = 0; j < numberOfCities; ++j) {
+            if (i != j) {
+                nearest[i].push_back(j);
+                minOut[i] = min(minOut[i], distanceMatrix(i, j));
+            }
+        }
+        sort(nearest[i].begin(), nearest[i].end(),
+             [&](int a, int b) { return distanceMatrix(i, a) < distanceMatrix(i, b); });
+    }
+
+    // Prefiksy (0, a, b) od najtańszego - szybciej znaleziona dobra trasa
+    // to silniejsze odcinanie w pozostałych
+    vector<pair<int, int>> prefixes;
+    for (int a = 1; a < numberOfCities; ++a) {
+        for (int b = 1; b < numberOfCities; ++b) {
+            if (a != b) {
+                prefixes.emplace_back(a, b);
+            }
+        }
+    }
+    auto prefixCost = [&](const pair<int, int>& prefix) {
+        return distanceMatrix(0, prefix.first) + distanceMatrix(prefix.first, prefix.second);
+    };
+    stable_sort(prefixes.begin(), prefixes.end(),
+                [&](const pair<int, int>& lhs, const pair<int, int>& rhs) { return prefixCost(lhs) < prefixCost(rhs); });
+
+    SharedBest shared(nearest_neighbor_route(nearest, distanceMatrix), "full_review");
+    atomic<int> nextPrefix(0);
+    atomic<long long> iterations(0);
+    SearchData data{distanceMatrix, move(nearest), move(minOut), distanceMatrix.symmetric(), maxIterations, shared, iterations};
+
+    auto work = [&]() {
+        PrefixSearch search(data);
+        for (int prefix = nextPrefix++; prefix < static_cast<int>(prefixes.size()); prefix = nextPrefix++) {
+            if (!search.run(prefixes[prefix].first, prefixes[prefix].second)) {
+                break;
+            }
+        }
+        search.flush();
+    };
+
+    // Przy małym limicie iteracji wystarczy jeden wątek
+    int workers = maxIterations < ITERATION_BATCH * threads ? 1 : min<int>(threads, prefixes.size());
+    if (workers <= 1) {
+        work();
+    } else {
+        vector<thread> pool;
+        for (int t = 0; t < workers; ++t) {
+            pool.emplace_back(work);
+        }
+        for (auto& worker : pool) {
+            worker.join();
+        }
+    }
+
+    iteration_count = static_cast<int>(min<long long>(iterations, numeric_limits<int>::max()));
+    return shared.best();
+}
@@ -0,0 +1,310 @@
+#include "tsp.h"
+#include "barrier.h"
+#include "trace.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Koszt trasy zapisanej w wierszu populacji
+double tour_cost(const int* cities, int n, const DistanceMatrix& distanceMatrix) {
+    double totalCost = 0.0;
+    for (int i = 0; i + 1 < n; ++i) {
+        totalCost += distanceMatrix(cities[i], cities[i + 1]);
+    }
+    return totalCost + distanceMatrix(cities[n - 1], cities[0]);
+}
+
+// Populacja przechowywana jako płaska macierz miast: osobnik i zajmuje
+// wiersz genes[i * n .. i * n + n - 1]
+class Population {
+public:
+    Population(int size = 0, int n = 0) : n(n), genes(static_cast<size_t>(size) * n), costs(size) {}
+
+    int size() const { return costs.size(); }
+
+    int* row(int i) { return genes.data() + static_cast<size_t>(i) * n; }
+    const int* row(int i) const { return genes.data() + static_cast<size_t>(i) * n; }
+
+    double& cost(int i) { return costs[i]; }
+    double cost(int i) const { return costs[i]; }
+
+    void copy_from(int i, const int* cities, double cost) {
+        copy(cities, cities + n, row(i));
+        costs[i] = cost;
+    }
+
+    // Indeksy osobników od najlepszego
+    vector<int> ranking() const {
+        vector<int> order(size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int a, int b) { return costs[a] < costs[b]; });
+        return order;
+    }
+
+private:
+    int n;
+    vector<int> genes;
+    vector<double> costs;
+};
+
+// Operatory genetyczne z buforami roboczymi jednej wyspy
+class Operators {
+public:
+    Operators(int n, mt19937& rgen) : n(n), rgen(rgen), used(n), adjacency(4 * n), degree(n), remaining(n), where(n) {}
+
+    // Krzyżowanie porządkowe (OX): fragment pierwszego rodzica na swoim
+    // miejscu, pozostałe miasta w kolejności z drugiego, od końca fragmentu
+    void order_crossover(const int* first, const int* second, int* child) {
+        uniform_int_distribution<int> position(0, n - 1);
+        int a = position(rgen);
+        int b = position(rgen);
+        if (a > b) {
+            swap(a, b);
+        }
+        fill(used.begin(), used.end(), 0);
+        for (int i = a; i <= b; ++i) {
+            child[i] = first[i];
+            used[first[i]] = 1;
+        }
+        int target = (b + 1) % n;
+        for (int k = 0; k < n; ++k) {
+            int city = second[(b + 1 + k) % n];
+            if (!used[city]) {
+                child[target] = city;
+                target = (target + 1) % n;
+            }
+        }
+    }
+
+    // Krzyżowanie z rekombinacją krawędzi (ERX): kolejne miasto to sąsiad
+    // bieżącego (w którymkolwiek rodzicu) o najmniejszej liczbie pozostałych
+    // sąsiadów; gdy takiego nie ma - losowe nieodwiedzone miasto
+    void edge_recombination(const int* first, const int* second, int* child) {
+        fill(degree.begin(), degree.end(), 0);
+        auto add_edge = [&](int a, int b) {
+            int* neighbors = &adjacency[4 * a];
+            for (int k = 0; k < degree[a]; ++k) {
+                if (neighbors[k] == b) {
+                    return;
+                }
+            }
+            neighbors[degree[a]++] = b;
+        };
+        for (const int* parent : {first, second}) {
+            for (int i = 0; i < n; ++i) {
+                int a = parent[i];
+                int b = parent[(i + 1) % n];
+                add_edge(a, b);
+                add_edge(b, a);
+            }
+        }
+        // Nieodwiedzone miasta z indeksem pozycji - usuwanie w O(1)
+        iota(remaining.begin(), remaining.end(), 0);
+        iota(where.begin(), where.end(), 0);
+        int remainingCount = n;
+        auto visit = [&](int city) {
+            int last = remaining[--remainingCount];
+            remaining[where[city]] = last;
+            where[last] = where[city];
+            where[city] = -1;
+            for (int k = 0; k < degree[city]; ++k) {
+                int neighbor = adjacency[4 * city + k];
+                int* list = &adjacency[4 * neighbor];
+                for (int m = 0; m < degree[neighbor]; ++m) {
+                    if (list[m] == city) {
+                        list[m] = list[--degree[neighbor]];
+                        break;
+                    }
+                }
+            }
+        };
+
+        int current = first[0];
+        for (int i = 0; i < n; ++i) {
+            child[i] = current;
+            visit(current);
+            if (remainingCount == 0) {
+                break;
+            }
+            int next = -1;
+            int ties = 0;
+            for (int k = 0; k < degree[current]; ++k) {
+                int neighbor = adjacency[4 * current + k];
+                if (next < 0 || degree[neighbor] < degree[next]) {
+                    next = neighbor;
+                    ties = 1;
+                } else if (degree[neighbor] == degree[next] && uniform_int_distribution<int>(0, ties++)(rgen) == 0) {
+                    next = neighbor;
+                }
+            }
+            if (next < 0) {
+                next = remaining[uniform_int_distribution<int>(0, remainingCount - 1)(rgen)];
+            }
+            current = next;
+        }
+    }
+
+    // Mutacja przez inwersję losowego fragmentu
+    void mutate(int* cities) {
+        uniform_int_distribution<int> position(0, n - 1);
+        int a = position(rgen);
+        int b = position(rgen);
+        if (a > b) {
+            swap(a, b);
+        }
+        reverse(cities + a, cities + b + 1);
+    }
+
+private:
+    int n;
+    mt19937& rgen;
+    vector<char> used;
+    vector<int> adjacency;
+    vector<int> degree;
+    vector<int> remaining;
+    vector<int> where;
+};
+
+} // namespace
+
+// Algorytm genetyczny w modelu wyspowym. Każda wyspa (wątek) rozwija własną
+// populację: elita przechodzi bez zmian, reszta to potomkowie rodziców
+// wybranych turniejowo, krzyżowanych OX lub ERX i mutowanych inwersją. Co
+// migrationInterval pokoleń wyspy spotykają się na barierze i przekazują
+// migrants najlepszych osobników następnej wyspie w pierścieniu, gdzie
+// zastępują one najgorsze.
+Route solve_genetic(const DistanceMatrix& distanceMatrix, int populationSize, int generations, int& iteration_count,
+                    CrossoverType crossover, double mutationRate, int islands, int migrationInterval, int migrants,
+                    unsigned seed) {
+    int numberOfCities = distanceMatrix.size();
+    iteration_count = 0;
+    if (numberOfCities <= 3) {
+        return generate_random_solution(numberOfCities, distanceMatrix);
+    }
+    if (islands <= 0) {
+        islands = max(1u, thread::hardware_concurrency());
+    }
+    populationSize = max(populationSize, 4);
+    migrationInterval = max(1, migrationInterval);
+    migrants = clamp(migrants, 0, populationSize / 2);
+    int elites = min(2, populationSize - 1);
+    const int tournamentSize = 3;
+
+    // Skrzynki migrantów: wyspa i wystawia osobników w outbox[i], po barierze
+    // odbiera je wyspa (i + 1) % islands z inbox
+    vector<Population> outbox(islands, Population(migrants, numberOfCities));
+    vector<Population> inbox(islands, Population(migrants, numberOfCities));
+    vector<Route> islandBest(islands, Route{{}, numeric_limits<double>::infinity()});
+
+    Trace trace("genetic");
+
+    int migration = 0;
+    auto exchange = [&]() {
+        for (int i = 0; i < islands; ++i) {
+            swap(inbox[(i + 1) % islands], outbox[i]);
+        }
+        ++migration;
+        double best = numeric_limits<double>::infinity();
+        for (const Route& route : islandBest) {
+            best = min(best, route.cost);
+        }
+        trace.record(static_cast<long long>(migration) * migrationInterval, best);
+    };
+    Barrier barrier(islands, exchange);
+
+    auto work = [&](int island) {
+        RandomStream stream(seed, island);
+        mt19937& rgen = random_engine();
+        Operators operators(numberOfCities, rgen);
+        uniform_int_distribution<int> pick(0, populationSize - 1);
+        uniform_real_distribution<double> chance(0.0, 1.0);
+
+        Population current(populationSize, numberOfCities);
+        Population next(populationSize, numberOfCities);
+        for (int i = 0; i < populationSize; ++i) {
+            Route route = generate_random_solution(numberOfCities, distanceMatrix);
+            current.copy_from(i, route.cities.data(), route.cost);
+        }
+        auto tournament = [&]() {
+            int winner = pick(rgen);
+            for (int k = 1; k < tournamentSize; ++k) {
+                int rival = pick(rgen);
+                if (current.cost(rival) < current.cost(winner)) {
+                    winner = rival;
+                }
+            }
+            return current.row(winner);
+        };
+
+        Route& best = islandBest[island];
+        for (int generation = 1; generation <= generations; ++generation) {
+            vector<int> ranking = current.ranking();
+            if (current.cost(ranking[0]) < best.cost) {
+                best = {vector<int>(current.row(ranking[0]), current.row(ranking[0]) + numberOfCities), current.cost(ranking[0])};
+            }
+            for (int e = 0; e < elites; ++e) {
+                next.copy_from(e, current.row(ranking[e]), current.cost(ranking[e]));
+            }
+            for (int i = elites; i < populationSize; ++i) {
+                int* child = next.row(i);
+                const int* first = tournament();
+                const int* second = tournament();
+                if (crossover == CrossoverType::EdgeRecombination) {
+                    operators.edge_recombination(first, second, child);
+                } else {
+                    operators.order_crossover(first, second, child);
+                }
+                if (chance(rgen) < mutationRate) {
+                    operators.mutate(child);
+                }
+                next.cost(i) = tour_cost(child, numberOfCities, distanceMatrix);
+            }
+            swap(current, next);
+
+            if (generation % migrationInterval == 0 && islands > 1) {
+                ranking = current.ranking();
+                for (int m = 0; m < migrants; ++m) {
+                    outbox[island].copy_from(m, current.row(ranking[m]), current.cost(ranking[m]));
+                }
+                barrier.arrive_and_wait();
+                for (int m = 0; m < migrants; ++m) {
+                    int worst = ranking[populationSize - 1 - m];
+                    current.copy_from(worst, inbox[island].row(m), inbox[island].cost(m));
+                }
+            }
+        }
+        for (int i = 0; i < populationSize; ++i) {
+            if (current.cost(i) < best.cost) {
+                best = {vector<int>(current.row(i), current.row(i) + numberOfCities), current.cost(i)};
+            }
+        }
+    };
+
+    if (islands == 1) {
+        work(0);
+    } else {
+        vector<thread> pool;
+        for (int island = 0; island < islands; ++island) {
+            pool.emplace_back(work, island);
+        }
+        for (auto& worker : pool) {
+            worker.join();
+        }
+    }
+
+    Route bestRoute = islandBest[0];
+    for (const Route& route : islandBest) {
+        if (route.cost < bestRoute.cost) {
+            bestRoute = route;
+        }
+    }
+    iteration_count = static_cast<int>(min<long long>(static_cast<long long>(generations) * islands, numeric_limits<int>::max()));
+    return bestRoute;
+}
@@ -0,0 +1,200 @@
+#include "tsp.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Symbol Newtona C(n, k) dla n <= 32
+class Binomial {
+public:
+    Binomial() {
+        for (int n = 0; n <= 32; ++n) {
+            table[n][0] = 1;
+            for (int k = 1; k <= n; ++k) {
+                table[n][k] = table[n - 1][k - 1] + (k <= n - 1 ? table[n - 1][k] : 0);
+            }
+        }
+    }
+
+    uint64_t operator()(int n, int k) const { return (k < 0 || k > n) ? 0 : table[n][k]; }
+
+private:
+    uint64_t table[33][33] = {};
+};
+
+const Binomial binomial;
+
+// Pozycja podzbioru w porządku koleksykograficznym wśród podzbiorów tej samej
+// mocy - to ten sam porządek, w którym maski rosną liczbowo
+uint64_t subset_rank(uint32_t mask) {
+    uint64_t rank = 0;
+    int index = 1;
+    while (mask) {
+        int bit = __builtin_ctz(mask);
+        rank += binomial(bit, index++);
+        mask &= mask - 1;
+    }
+    return rank;
+}
+
+// Odwrotność subset_rank dla podzbiorów mocy size
+uint32_t subset_unrank(uint64_t rank, int size) {
+    uint32_t mask = 0;
+    for (int index = size; index >= 1; --index) {
+        int bit = index - 1;
+        while (binomial(bit + 1, index) <= rank) {
+            ++bit;
+        }
+        rank -= binomial(bit, index);
+        mask |= 1u << bit;
+    }
+    return mask;
+}
+
+// Następny podzbiór tej samej mocy (Gosper's hack)
+uint32_t next_subset(uint32_t mask) {
+    uint32_t lowest = mask & -mask;
+    uint32_t ripple = mask + lowest;
+    return ripple | (((mask ^ ripple) >> 2) / lowest);
+}
+
+// Indeks bitu wśród ustawionych bitów maski
+int bit_index(uint32_t mask, int bit) {
+    return __builtin_popcount(mask & ((1u << bit) - 1));
+}
+
+} // namespace
+
+// Programowanie dynamiczne Helda-Karpa. Miasto 0 jest początkiem trasy, pozostałe
+// miasta 1..n-1 to bity maski. Stan (S, j) to najkrótsza ścieżka z 0 przez
+// wszystkie miasta S, kończąca się w j ∈ S. Koszty trzymane są tylko dla dwóch
+// kolejnych warstw (moc |S|), a w warstwie tylko dla j ∈ S - wiersz podzbioru ma
+// |S| elementów i jest adresowany rangą podzbioru. Dla odtworzenia trasy zapamiętany
+// jest poprzednik każdego stanu (1 bajt). Każda warstwa liczona jest równolegle.
+Route solve_held_karp(const DistanceMatrix& distanceMatrix, int& iteration_count, int threads) {
+    int numberOfCities = distanceMatrix.size();
+    iteration_count = 0;
+    if (numberOfCities > HELD_KARP_MAX_CITIES) {
+        cerr << "Held-Karp: zbyt wiele miast (" << numberOfCities << " > " << HELD_KARP_MAX_CITIES << ")" << endl;
+        return {{}, numeric_limits<double>::infinity()};
+    }
+    if (numberOfCities <= 3) {
+        Route route;
+        for (int i = 0; i < numberOfCities; ++i) {
+            route.cities.push_back(i);
+        }
+        route.cost = numberOfCities > 0 ? check_cost(route.cities, distanceMatrix) : 0.0;
+        route.hash = tour_hash(route.cities);
+        if (numberOfCities == 3) {
+            vector<int> other{0, 2, 1};
+            double otherCost = check_cost(other, distanceMatrix);
+            if (otherCost < route.cost) {
+                route = {other, otherCost};
+            }
+        }
+        return route;
+    }
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+
+    int m = numberOfCities - 1;
+    // Odległość między miastami o bitach a, b (bit b to miasto b + 1)
+    auto dist = [&](int a, int b) { return distanceMatrix(a + 1, b + 1); };
+
+    vector<double> previous(m);
+    vector<vector<uint8_t>> parents(m + 1);
+    for (int j = 0; j < m; ++j) {
+        previous[j] = distanceMatrix(0, j + 1);
+    }
+    parents[1].assign(m, UINT8_MAX);
+    long long states = m;
+
+    vector<double> current;
+    for (int size = 2; size <= m; ++size) {
+        uint64_t subsets = binomial(m, size);
+        current.assign(subsets * size, numeric_limits<double>::infinity());
+        parents[size].assign(subsets * size, UINT8_MAX);
+        states += subsets * size;
+
+        auto work = [&](uint64_t firstRank, uint64_t lastRank) {
+            uint32_t mask = subset_unrank(firstRank, size);
+            for (uint64_t rank = firstRank; rank < lastRank; ++rank, mask = next_subset(mask)) {
+                double* row = current.data() + rank * size;
+                uint8_t* parentRow = parents[size].data() + rank * size;
+                int p = 0;
+                for (uint32_t rest = mask; rest; rest &= rest - 1, ++p) {
+                    int j = __builtin_ctz(rest);
+                    uint32_t prevMask = mask & ~(1u << j);
+                    const double* prevRow = previous.data() + subset_rank(prevMask) * (size - 1);
+                    double best = numeric_limits<double>::infinity();
+                    uint8_t bestParent = UINT8_MAX;
+                    int q = 0;
+                    for (uint32_t prevRest = prevMask; prevRest; prevRest &= prevRest - 1, ++q) {
+                        int i = __builtin_ctz(prevRest);
+                        double candidate = prevRow[q] + dist(i, j);
+                        if (candidate < best) {
+                            best = candidate;
+                            bestParent = i;
+                        }
+                    }
+                    row[p] = best;
+                    parentRow[p] = bestParent;
+                }
+            }
+        };
+
+        // Podział warstwy na ciągłe zakresy rang - każdy wątek pisze własne wiersze
+        int workers = static_cast<int>(min<uint64_t>(threads, max<uint64_t>(1, subsets / 64)));
+        if (workers <= 1) {
+            work(0, subsets);
+        } else {
+            vector<thread> pool;
+            for (int t = 0; t < workers; ++t) {
+                uint64_t first = subsets * t / workers;
+                uint64_t last = subsets * (t + 1) / workers;
+                pool.emplace_back(work, first, last);
+            }
+            for (auto& worker : pool) {
+                worker.join();
+            }
+        }
+        previous.swap(current);
+    }
+
+    // Domknięcie cyklu do miasta 0; ostatnia warstwa ma jeden podzbiór
+    uint32_t fullMask = (1u << m) - 1;
+    double bestCost = numeric_limits<double>::infinity();
+    int last = -1;
+    for (int j = 0; j < m; ++j) {
+        double candidate = previous[j] + distanceMatrix(j + 1, 0);
+        if (candidate < bestCost) {
+            bestCost = candidate;
+            last = j;
+        }
+    }
+
+    // Odtworzenie trasy od końca po zapamiętanych poprzednikach
+    vector<int> reversedTour;
+    uint32_t mask = fullMask;
+    for (int size = m; size >= 1; --size) {
+        reversedTour.push_back(last + 1);
+        int parent = parents[size][subset_rank(mask) * size + bit_index(mask, last)];
+        mask &= ~(1u << last);
+        last = parent;
+    }
+
+    Route bestRoute;
+    bestRoute.cities.push_back(0);
+    bestRoute.cities.insert(bestRoute.cities.end(), reversedTour.rbegin(), reversedTour.rend());
+    bestRoute.cost = bestCost;
+    bestRoute.hash = tour_hash(bestRoute.cities);
+    iteration_count = static_cast<int>(min<long long>(states, numeric_limits<int>::max()));
+    return bestRoute;
+}
@@ -0,0 +1,265 @@
+#include "tsp.h"
+#include "candidate_list.h"
+#include "dont_look_bits.h"
+#include "trace.h"
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Trasa w postaci tablicy miast i odwrotnej tablicy pozycji. Kierunek obiegu
+// może być logicznie odwrócony (flipped), dzięki czemu odwracając fragment
+// trasy zawsze odwracamy krótszą z dwóch części cyklu.
+class LkTour {
+public:
+    explicit LkTour(const vector<int>& cities) : cities(cities), pos(cities.size()) {
+        for (size_t i = 0; i < cities.size(); ++i) {
+            pos[cities[i]] = i;
+        }
+    }
+
+    int size() const { return cities.size(); }
+
+    int succ(int city) const {
+        int n = size();
+        return cities[flipped ? (pos[city] + n - 1) % n : (pos[city] + 1) % n];
+    }
+
+    int pred(int city) const {
+        int n = size();
+        return cities[flipped ? (pos[city] + 1) % n : (pos[city] + n - 1) % n];
+    }
+
+    // Odwrócenie zakresu pozycji p..q, ewentualnie ze zmianą kierunku obiegu
+    struct Reversal {
+        int p;
+        int q;
+        bool flip;
+    };
+
+    // Odwraca fragment from -> ... -> to (w bieżącym kierunku obiegu).
+    // Zwraca opis operacji potrzebny do jej cofnięcia.
+    Reversal reverse_path(int from, int to) {
+        int n = size();
+        int p = pos[from];
+        int q = pos[to];
+        if (flipped) {
+            swap(p, q);
+        }
+        int length = (q - p + n) % n + 1;
+        if (2 * length > n) {
+            // Odwrócenie dopełnienia daje ten sam cykl w przeciwnym kierunku
+            Reversal complement{(q + 1) % n, (p + n - 1) % n, true};
+            reverse_positions(complement.p, complement.q);
+            flipped = !flipped;
+            return complement;
+        }
+        reverse_positions(p, q);
+        return {p, q, false};
+    }
+
+    void undo(const Reversal& operation) {
+        reverse_positions(operation.p, operation.q);
+        if (operation.flip) {
+            flipped = !flipped;
+        }
+    }
+
+    // Zmiana kierunku obiegu - ten sam cykl, zamienione succ i pred
+    void flip_orientation() { flipped = !flipped; }
+
+    vector<int> to_route() const {
+        vector<int> route(cities);
+        if (flipped) {
+            reverse(route.begin(), route.end());
+        }
+        return route;
+    }
+
+private:
+    // Odwraca cyklicznie pozycje p..q (włącznie)
+    void reverse_positions(int p, int q) {
+        int n = size();
+        int length = (q - p + n) % n + 1;
+        for (int k = 0; k < length / 2; ++k) {
+            int a = (p + k) % n;
+            int b = (q - k + n) % n;
+            swap(cities[a], cities[b]);
+            pos[cities[a]] = a;
+            pos[cities[b]] = b;
+        }
+    }
+
+    vector<int> cities;
+    vector<int> pos;
+    bool flipped = false;
+};
+
+class LinKernighan {
+public:
+    LinKernighan(const DistanceMatrix& distanceMatrix, LkTour& tour, int maxDepth, int maxBreadth, int candidates)
+        : distanceMatrix(distanceMatrix), tour(tour), maxDepth(maxDepth), maxBreadth(maxBreadth),
+          candidateList(distanceMatrix, candidates) {}
+
+    // Próba poprawy trasy sekwencją wymian krawędzi zaczynającą się w mieście t1,
+    // najpierw od krawędzi (t1, succ(t1)), potem od (t1, pred(t1)).
+    // Zwraca uzyskany zysk (0, jeśli trasa nie uległa zmianie); końce zmienionych
+    // krawędzi trafiają wtedy do touched().
+    double improve_from(int t1) {
+        double gain = improve_from_successor(t1);
+        if (gain > 0.0) {
+            return gain;
+        }
+        tour.flip_orientation();
+        gain = improve_from_successor(t1);
+        tour.flip_orientation();
+        return gain;
+    }
+
+    const vector<int>& touched() const { return touchedCities; }
+
+private:
+    // Wymiana krawędzi w łańcuchu: (t1, t2), (t4, t3) -> (t2, t3), (t4, t1)
+    struct Exchange {
+        LkTour::Reversal reversal;
+        int t2;
+        int t3;
+        int t4;
+    };
+
+    double improve_from_successor(int t1) {
+        this->t1 = t1;
+        bestGain = 0.0;
+        bestDepth = 0;
+        operations.clear();
+        int t2 = tour.succ(t1);
+        step(0, cost(t1, t2));
+        // Cofamy wymiany wykonane za najlepszym punktem łańcucha
+        while (static_cast<int>(operations.size()) > bestDepth) {
+            tour.undo(operations.back().reversal);
+            operations.pop_back();
+        }
+        touchedCities.clear();
+        if (bestGain > 0.0) {
+            touchedCities.push_back(t1);
+            for (const Exchange& exchange : operations) {
+                touchedCities.insert(touchedCities.end(), {exchange.t2, exchange.t3, exchange.t4});
+            }
+        }
+        return bestGain;
+    }
+
+    // Dla macierzy niesymetrycznej LK operuje na średniej z obu kierunków
+    double cost(int a, int b) const {
+        if (distanceMatrix.symmetric()) {
+            return distanceMatrix(a, b);
+        }
+        return 0.5 * (distanceMatrix(a, b) + distanceMatrix(b, a));
+    }
+
+    // Jeden poziom przeszukiwania: usunięta krawędź (t1, t2), dodajemy (t2, t3),
+    // usuwamy (t4, t3) i domykamy trasę krawędzią (t4, t1). gain to suma długości
+    // usuniętych krawędzi minus dodanych, wliczając (t1, t2).
+    bool step(int depth, double gain) {
+        int t2 = tour.succ(t1);
+        int breadth = max(1, maxBreadth >> depth);
+        int tried = 0;
+        const int* candidates = candidateList.of(t2);
+        for (int c = 0; c < candidateList.k() && tried < breadth; ++c) {
+            int t3 = candidates[c];
+            double partialGain = gain - cost(t2, t3);
+            if (partialGain <= 0.0) {
+                break; // Kandydaci są posortowani - dalsi nie spełnią kryterium zysku
+            }
+            if (t3 == t1 || t3 == tour.succ(t2)) {
+                continue;
+            }
+            int t4 = tour.pred(t3);
+            ++tried;
+
+            double closedGain = partialGain + cost(t4, t3) - cost(t4, t1);
+            operations.push_back({tour.reverse_path(t2, t4), t2, t3, t4});
+            if (closedGain > bestGain + 1e-9) {
+                bestGain = closedGain;
+                bestDepth = operations.size();
+            }
+            if (depth + 1 < maxDepth) {
+                step(depth + 1, partialGain + cost(t4, t3));
+            }
+            if (bestGain > 1e-9) {
+                return true;
+            }
+            tour.undo(operations.back().reversal);
+            operations.pop_back();
+        }
+        return false;
+    }
+
+    const DistanceMatrix& distanceMatrix;
+    LkTour& tour;
+    int maxDepth;
+    int maxBreadth;
+    CandidateList candidateList;
+
+    int t1 = 0;
+    double bestGain = 0.0;
+    int bestDepth = 0;
+    vector<Exchange> operations;
+    vector<int> touchedCities;
+};
+
+} // namespace
+
+// Przeszukiwanie lokalne w stylu Lina-Kernighana: sekwencyjne wymiany krawędzi
+// o zmiennej głębokości (do maxDepth) i szerokości malejącej z poziomem,
+// ograniczone do list kandydatów najbliższych miast
+Route solve_lin_kernighan(const DistanceMatrix& distanceMatrix, int maxIterations, int& iteration_count,
+                          int maxDepth, int maxBreadth, int candidates) {
+    int numberOfCities = distanceMatrix.size();
+    Route currentRoute = generate_random_solution(numberOfCities, distanceMatrix);
+    iteration_count = 0;
+    if (numberOfCities < 4) {
+        return currentRoute;
+    }
+
+    LkTour tour(currentRoute.cities);
+    LinKernighan lk(distanceMatrix, tour, maxDepth, maxBreadth, candidates);
+
+    Trace trace("lin_kernighan");
+
+    // Bity "nie patrz": po udanej wymianie ponownie sprawdzane są tylko miasta,
+    // których krawędzie się zmieniły. Runda obejmuje miasta aktywne na jej początku.
+    DontLookBits dontLook(numberOfCities);
+    for (int city : currentRoute.cities) {
+        dontLook.activate(city);
+    }
+    while (!dontLook.empty() && iteration_count < maxIterations) {
+        for (size_t remaining = dontLook.size(); remaining > 0 && !dontLook.empty(); --remaining) {
+            int t1 = dontLook.pop();
+            if (lk.improve_from(t1) > 0.0) {
+                for (int city : lk.touched()) {
+                    dontLook.activate(city);
+                }
+            }
+        }
+        iteration_count++;
+        currentRoute.cities = tour.to_route();
+        currentRoute.cost = check_cost(currentRoute.cities, distanceMatrix);
+        trace.record(iteration_count, currentRoute.cost);
+    }
+
+    // Dla macierzy niesymetrycznej wybieramy korzystniejszy kierunek obiegu
+    if (!distanceMatrix.symmetric()) {
+        vector<int> reversedCities(currentRoute.cities.rbegin(), currentRoute.cities.rend());
+        double reversedCost = check_cost(reversedCities, distanceMatrix);
+        if (reversedCost < currentRoute.cost) {
+            currentRoute.cities = reversedCities;
+            currentRoute.cost = reversedCost;
+        }
+    }
+    // Trasa pochodzi z LkTour, a nie z apply_move - skrót liczony od nowa
+    currentRoute.hash = tour_hash(currentRoute.cities);
+    return currentRoute;
+}
@@ -1,19 +1,47 @@
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <cstdlib>
 #include <chrono>
-#include <sys/resource.h> // for getrusage
 #include "tsp.h"
+#include "allocation_stats.h"
+#include "perf_counters.h"
+#include "trace.h"
+#include "tsplib.h"
 #include <fstream> // Dodano do obsługi plików
 
 using namespace std;
 using namespace std::chrono;
 
-// Funkcja do pobierania zużycia pamięci
-long getCurrentMemoryUsage() {
-    struct rusage usage;
-    getrusage(RUSAGE_SELF, &usage);
-    return usage.ru_maxrss;
+// Zużycie sterty przez algorytm: szczyt zajętości oraz suma i liczba alokacji
+void displayMemory(const AllocationStats& stats) {
+    cout << "Zużycie pamięci: " << stats.peakLiveBytes / 1024.0 << " KB (szczyt), zaalokowano "
+         << stats.allocatedBytes / 1024.0 << " KB w " << stats.allocations << " alokacjach" << endl;
+}
+
+// Liczniki sprzętowe algorytmu (tylko dostępne, nic przy wyłączonym -perf)
+void displayPerf(const PerfReading& reading) {
+    const pair<PerfEvent, const char*> names[] = {
+        {PerfEvent::Cycles, "cykle"},
+        {PerfEvent::Instructions, "instrukcje"},
+        {PerfEvent::L1dMisses, "chybienia L1d"},
+        {PerfEvent::LlcMisses, "chybienia LLC"},
+        {PerfEvent::BranchMisses, "błędne predykcje skoków"},
+    };
+    string line;
+    for (const auto& [event, name] : names) {
+        if (reading.has(event)) {
+            line += (line.empty() ? "" : ", ") + string(name) + " " + to_string(reading[event]);
+        }
+    }
+    if (line.empty()) {
+        return;
+    }
+    cout << "Liczniki: " << line;
+    if (reading.ipc() > 0.0) {
+        cout << ", IPC " << reading.ipc();
+    }
+    cout << endl;
 }
 
 void displayRoute(const vector<int>& cities, const vector<string>& cityNames) {
@@ -28,11 +56,88 @@ void displayRoute(const vector<int>& cities, const vector<string>& cityNames) {
     cout << endl;
 }
 
+// Instancje TSPLIB EUC_2D / CEIL_2D / GEO i pliki współrzędnych geograficznych
+// (-latlon) większe od tej liczby miast nie są rozwijane do macierzy odległości
+// (n² liczb) - uruchamiane są wtedy tylko algorytmy z tsp.cpp, liczące odległości
+// ze współrzędnych (dla GEO i -latlon wzorem haversine)
+constexpr int DENSE_MATRIX_MAX_CITIES = 10000;
+
+// Algorytmy z tsp.cpp na dostawcy odległości liczonych ze współrzędnych. Trasy
+// nie są wypisywane (instancje mają zwykle tysiące miast), a Tabu Search jest
+// pominięty - jego pamięć krawędzi ma rozmiar n².
+template <typename Distances>
+void solveWithoutMatrix(const Distances& distances, int maxIterations, ImprovementStrategy strategy,
+                        NeighborhoodType neighborhood, int candidates, PerfCounters& perf) {
+    auto measure = [&](const string& title, auto solve) {
+        int iterations = 0;
+        auto start = high_resolution_clock::now();
+        AllocationScope allocations;
+        perf.start();
+        Route route = solve(iterations);
+        PerfReading counters = perf.stop();
+        AllocationStats memory = allocations.stop();
+        duration<double, milli> elapsed = high_resolution_clock::now() - start;
+
+        cout << "\n" << title << " (" << distances.size() << " miast, odległości ze współrzędnych):\n";
+        cout << "Koszt: " << route.cost << " km" << endl;
+        cout << "Czas wykonania: " << elapsed.count() << " ms" << endl;
+        cout << "Liczba iteracji: " << iterations << endl;
+        displayMemory(memory);
+        displayPerf(counters);
+    };
+
+    measure("Losowa trasa", [&](int& iterations) {
+        iterations = 0;
+        return generate_random_solution(distances.size(), distances);
+    });
+    measure("Trasa po algorytmie wspinaczkowym", [&](int& iterations) {
+        return solve_hill_climbing(distances, maxIterations, iterations, strategy, neighborhood, candidates);
+    });
+    measure("Trasa po algorytmie wspinaczkowym z losowym wyborem sąsiada", [&](int& iterations) {
+        return solve_random_hill_climbing(distances, maxIterations, iterations);
+    });
+    auto T = [](int iteration) -> double { return 10000.0 / iteration; }; // Funkcja temperatury
+    measure("Trasa po algorytmie wyżarzania", [&](int& iterations) {
+        return solve_simulated_annealing(distances, T, maxIterations, iterations, neighborhood);
+    });
+}
+
+// Pełna macierz odległości z dostawcy liczącego je ze współrzędnych
+template <typename Distances>
+DistanceMatrix denseMatrix(const Distances& distances) {
+    DistanceMatrix matrix(distances.size());
+    for (size_t i = 0; i < distances.size(); ++i) {
+        distances.distances_from(i, 0, distances.size(), matrix.row(i));
+    }
+    matrix.update_symmetry();
+    return matrix;
+}
+
 int main(int argc, char* argv[]) {
 
     string filename = argv[1];
     int tabuSize = 10;
     int maxIterations = 1000;
+    ImprovementStrategy strategy = ImprovementStrategy::Best;
+    NeighborhoodType neighborhood = NeighborhoodType::Swap;
+    int candidates = 0;
+    double timeLimit = 10.0;
+    int starts = 0;
+    double targetCost = 0.0;
+    unsigned seed = random_device{}();  // -seed powtarza przebieg
+    int replicas = 8;
+    double minTemperature = 1.0;
+    double maxTemperature = 1000.0;
+    int populationSize = 100;
+    CrossoverType crossover = CrossoverType::Order;
+    int islands = 0;
+    int ants = 0;
+    TraceOptions traceOptions;
+    bool perfEnabled = false;
+    bool coordinatesOnly = false;
+    bool forceMatrix = false;
+    bool latLonInput = false;    // plik to współrzędne geograficzne miast (read_latlon_csv)
+    bool verifyChecksum = true;  // suma kontrolna macierzy binarnej (-noverify pomija)
 
     // Przetwarzanie argumentów linii komend
     for (int i = 2; i < argc; ++i) {
@@ -40,19 +145,136 @@ int main(int argc, char* argv[]) {
             tabuSize = atoi(argv[++i]);
         } else if (string(argv[i]) == "-i" && i + 1 < argc) {
             maxIterations = atoi(argv[++i]);
+        } else if (string(argv[i]) == "-first") {
+            strategy = ImprovementStrategy::First;
+        } else if (string(argv[i]) == "-k" && i + 1 < argc) {
+            candidates = atoi(argv[++i]);
+        } else if (string(argv[i]) == "-bb" && i + 1 < argc) {
+            timeLimit = atof(argv[++i]);
+        } else if (string(argv[i]) == "-starts" && i + 1 < argc) {
+            starts = atoi(argv[++i]);
+        } else if (string(argv[i]) == "-target" && i + 1 < argc) {
+            targetCost = atof(argv[++i]);
+        } else if (string(argv[i]) == "-seed" && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else if (string(argv[i]) == "-replicas" && i + 1 < argc) {
+            replicas = atoi(argv[++i]);
+        } else if (string(argv[i]) == "-tmin" && i + 1 < argc) {
+            minTemperature = atof(argv[++i]);
+        } else if (string(argv[i]) == "-tmax" && i + 1 < argc) {
+            maxTemperature = atof(argv[++i]);
+        } else if (string(argv[i]) == "-pop" && i + 1 < argc) {
+            populationSize = atoi(argv[++i]);
+        } else if (string(argv[i]) == "-islands" && i + 1 < argc) {
+            islands = atoi(argv[++i]);
+        } else if (string(argv[i]) == "-crossover" && i + 1 < argc) {
+            string name = argv[++i];
+            if (name == "ox") {
+                crossover = CrossoverType::Order;
+            } else if (name == "erx") {
+                crossover = CrossoverType::EdgeRecombination;
+            } else {
+                cerr << "Nieznany typ krzyżowania: " << name << endl;
+                return 1;
+            }
+        } else if (string(argv[i]) == "-ants" && i + 1 < argc) {
+            ants = atoi(argv[++i]);
+        } else if (string(argv[i]) == "-trace" && i + 1 < argc) {
+            traceOptions.enabled = true;
+            traceOptions.directory = argv[++i];
+        } else if (string(argv[i]) == "-trace-every" && i + 1 < argc) {
+            traceOptions.sampling = TraceSampling::EveryK;
+            traceOptions.every = atoll(argv[++i]);
+        } else if (string(argv[i]) == "-trace-improvements") {
+            traceOptions.sampling = TraceSampling::Improvements;
+        } else if (string(argv[i]) == "-coords") {
+            coordinatesOnly = true;
+        } else if (string(argv[i]) == "-matrix") {
+            forceMatrix = true;
+        } else if (string(argv[i]) == "-latlon") {
+            latLonInput = true;
+        } else if (string(argv[i]) == "-noverify") {
+            verifyChecksum = false;
+        } else if (string(argv[i]) == "-perf") {
+            perfEnabled = true;
+        } else if (string(argv[i]) == "-n" && i + 1 < argc) {
+            string name = argv[++i];
+            if (name == "swap") {
+                neighborhood = NeighborhoodType::Swap;
+            } else if (name == "2opt") {
+                neighborhood = NeighborhoodType::TwoOpt;
+            } else if (name == "oropt") {
+                neighborhood = NeighborhoodType::OrOpt;
+            } else if (name == "3opt") {
+                neighborhood = NeighborhoodType::ThreeOpt;
+            } else {
+                cerr << "Nieznany rodzaj sąsiedztwa: " << name << endl;
+                return 1;
+            }
         }
     }
+    // Drabina geometryczna wymaga 0 < tmin <= tmax - inaczej temperatury są nieskończone lub NaN
+    if (minTemperature <= 0.0 || maxTemperature < minTemperature) {
+        cerr << "Niepoprawny zakres temperatur: -tmin " << minTemperature << " -tmax " << maxTemperature
+             << " (wymagane 0 < tmin <= tmax)" << endl;
+        return 1;
+    }
+    set_trace_options(traceOptions);
+    cout << "Ziarno algorytmów równoległych: " << seed << endl;
 
-    pair<vector<string>, vector<vector<double>>> data;
-    data = read_csv(filename);
+    // Liczniki sprzętowe są opcjonalne - przy braku dostępu program działa dalej bez nich
+    PerfCounters perf(perfEnabled);
+    if (perfEnabled && !perf.error().empty()) {
+        cerr << (perf.available() ? "Część liczników sprzętowych jest niedostępna: "
+                                  : "Liczniki sprzętowe są niedostępne: ")
+             << perf.error() << endl;
+    }
 
-    auto [cityNames, distanceMatrix] = data;
+    // Plik TSPLIB wczytywany jest raz - duże instancje ze współrzędnymi działają
+    // bez macierzy odległości (-coords wymusza, -matrix wyłącza), pozostałe
+    // dostają macierz zbudowaną z wczytanej instancji
+    vector<string> cityNames;
+    DistanceMatrix distanceMatrix;
+    if (latLonInput) {
+        // Współrzędne geograficzne - rzeczywiste odległości po okręgu wielkim
+        GeoCities cities = read_latlon_csv(filename);
+        HaversineDistances distances(cities.latitude, cities.longitude);
+        if (!forceMatrix && (coordinatesOnly || distances.size() > DENSE_MATRIX_MAX_CITIES)) {
+            solveWithoutMatrix(distances, maxIterations, strategy, neighborhood, candidates, perf);
+            return 0;
+        }
+        cityNames = move(cities.names);
+        distanceMatrix = denseMatrix(distances);
+    } else if (is_tsplib_file(filename)) {
+        TsplibInstance instance = read_tsplib(filename);
+        bool euclidean = instance.edgeWeightType == EdgeWeightType::Euc2d
+                      || instance.edgeWeightType == EdgeWeightType::Ceil2d;
+        if (!forceMatrix && euclidean && (coordinatesOnly || instance.size() > DENSE_MATRIX_MAX_CITIES)) {
+            DistanceRounding rounding = instance.edgeWeightType == EdgeWeightType::Euc2d ? DistanceRounding::Nearest
+                                                                                         : DistanceRounding::Up;
+            EuclideanDistances distances(instance.x, instance.y, rounding);
+            solveWithoutMatrix(distances, maxIterations, strategy, neighborhood, candidates, perf);
+            return 0;
+        }
+        bool geographic = instance.edgeWeightType == EdgeWeightType::Geo;
+        if (!forceMatrix && geographic && (coordinatesOnly || instance.size() > DENSE_MATRIX_MAX_CITIES)) {
+            solveWithoutMatrix(instance.geo_distances(), maxIterations, strategy, neighborhood, candidates, perf);
+            return 0;
+        }
+        cityNames = instance.city_names();
+        distanceMatrix = move(instance).distance_matrix();
+    } else {
+        // Bez kopii - macierz z pliku binarnego pozostaje widokiem na zmapowane strony
+        tie(cityNames, distanceMatrix) = read_instance(filename, verifyChecksum);
+    }
 
     // Generowanie losowego rozwiązania
     auto start_random = high_resolution_clock::now();
-    long mem_before_random = getCurrentMemoryUsage();
+    AllocationScope allocations_random;
+    perf.start();
     Route initialRoute = generate_random_solution(distanceMatrix.size(), distanceMatrix);
-    long mem_after_random = getCurrentMemoryUsage();
+    PerfReading counters_random = perf.stop();
+    AllocationStats memory_random = allocations_random.stop();
     auto end_random = high_resolution_clock::now();
     duration<double, milli> duration_random = end_random - start_random;
 
@@ -60,14 +282,17 @@ int main(int argc, char* argv[]) {
     displayRoute(initialRoute.cities, cityNames);
     cout << "Koszt: " << initialRoute.cost << " km" << endl;
     cout << "Czas wykonania: " << duration_random.count() << " ms" << endl;
-    cout << "Zużycie pamięci: " << (mem_after_random - mem_before_random) << " KB" << endl;
+    displayMemory(memory_random);
+    displayPerf(counters_random);
 
     // Algorytm wspinaczkowy
     int hill_climbing_iterations;
     auto start_hill = high_resolution_clock::now();
-    long mem_before_hill = getCurrentMemoryUsage();
-    Route hillClimbingRoute = solve_hill_climbing(distanceMatrix, maxIterations, hill_climbing_iterations);
-    long mem_after_hill = getCurrentMemoryUsage();
+    AllocationScope allocations_hill;
+    perf.start();
+    Route hillClimbingRoute = solve_hill_climbing(distanceMatrix, maxIterations, hill_climbing_iterations, strategy, neighborhood, candidates);
+    PerfReading counters_hill = perf.stop();
+    AllocationStats memory_hill = allocations_hill.stop();
     auto end_hill = high_resolution_clock::now();
     duration<double, milli> duration_hill = end_hill - start_hill;
 
@@ -76,14 +301,17 @@ int main(int argc, char* argv[]) {
     cout << "Koszt: " << hillClimbingRoute.cost << " km" << endl;
     cout << "Czas wykonania: " << duration_hill.count() << " ms" << endl;
     cout << "Liczba iteracji: " << hill_climbing_iterations << endl;
-    cout << "Zużycie pamięci: " << (mem_after_hill - mem_before_hill) << " KB" << endl;
+    displayMemory(memory_hill);
+    displayPerf(counters_hill);
 
     // Algorytm wspinaczkowy z losowym wyborem sąsiada
     int random_hill_climbing_iterations;
     auto start_random_hill = high_resolution_clock::now();
-    long mem_before_random_hill = getCurrentMemoryUsage();
+    AllocationScope allocations_random_hill;
+    perf.start();
     Route randomHillClimbingRoute = solve_random_hill_climbing(distanceMatrix, maxIterations, random_hill_climbing_iterations);
-    long mem_after_random_hill = getCurrentMemoryUsage();
+    PerfReading counters_random_hill = perf.stop();
+    AllocationStats memory_random_hill = allocations_random_hill.stop();
     auto end_random_hill = high_resolution_clock::now();
     duration<double, milli> duration_random_hill = end_random_hill - start_random_hill;
 
@@ -92,14 +320,37 @@ int main(int argc, char* argv[]) {
     cout << "Koszt: " << randomHillClimbingRoute.cost << " km" << endl;
     cout << "Czas wykonania: " << duration_random_hill.count() << " ms" << endl;
     cout << "Liczba iteracji: " << random_hill_climbing_iterations << endl;
-    cout << "Zużycie pamięci: " << (mem_after_random_hill - mem_before_random_hill) << " KB" << endl;
+    displayMemory(memory_random_hill);
+    displayPerf(counters_random_hill);
+
+    // Wielostartowy algorytm wspinaczkowy
+    int multi_start_iterations;
+    auto start_multi = high_resolution_clock::now();
+    AllocationScope allocations_multi;
+    perf.start();
+    Route multiStartRoute = solve_multi_start(distanceMatrix, starts, maxIterations, multi_start_iterations, false,
+                                              strategy, neighborhood, candidates, targetCost, seed);
+    PerfReading counters_multi = perf.stop();
+    AllocationStats memory_multi = allocations_multi.stop();
+    auto end_multi = high_resolution_clock::now();
+    duration<double, milli> duration_multi = end_multi - start_multi;
+
+    cout << "\nTrasa po wielostartowym algorytmie wspinaczkowym:\n";
+    displayRoute(multiStartRoute.cities, cityNames);
+    cout << "Koszt: " << multiStartRoute.cost << " km" << endl;
+    cout << "Czas wykonania: " << duration_multi.count() << " ms" << endl;
+    cout << "Liczba iteracji: " << multi_start_iterations << endl;
+    displayMemory(memory_multi);
+    displayPerf(counters_multi);
 
     // Algorytm Tabu Search
     int tabu_iterations;
     auto start_tabu = high_resolution_clock::now();
-    long mem_before_tabu = getCurrentMemoryUsage();
-    Route tabuRoute = solve_tabu(distanceMatrix, tabuSize, maxIterations, tabu_iterations);
-    long mem_after_tabu = getCurrentMemoryUsage();
+    AllocationScope allocations_tabu;
+    perf.start();
+    Route tabuRoute = solve_tabu(distanceMatrix, tabuSize, maxIterations, tabu_iterations, neighborhood, candidates);
+    PerfReading counters_tabu = perf.stop();
+    AllocationStats memory_tabu = allocations_tabu.stop();
     auto end_tabu = high_resolution_clock::now();
     duration<double, milli> duration_tabu = end_tabu - start_tabu;
 
@@ -108,15 +359,37 @@ int main(int argc, char* argv[]) {
     cout << "Koszt: " << tabuRoute.cost << " km" << endl;
     cout << "Czas wykonania: " << duration_tabu.count() << " ms" << endl;
     cout << "Liczba iteracji: " << tabu_iterations << endl;
-    cout << "Zużycie pamięci: " << (mem_after_tabu - mem_before_tabu) << " KB" << endl;
+    displayMemory(memory_tabu);
+    displayPerf(counters_tabu);
+
+    // Algorytm Lina-Kernighana
+    int lk_iterations;
+    auto start_lk = high_resolution_clock::now();
+    AllocationScope allocations_lk;
+    perf.start();
+    Route lkRoute = solve_lin_kernighan(distanceMatrix, maxIterations, lk_iterations);
+    PerfReading counters_lk = perf.stop();
+    AllocationStats memory_lk = allocations_lk.stop();
+    auto end_lk = high_resolution_clock::now();
+    duration<double, milli> duration_lk = end_lk - start_lk;
+
+    cout << "\nTrasa po algorytmie Lina-Kernighana:\n";
+    displayRoute(lkRoute.cities, cityNames);
+    cout << "Koszt: " << lkRoute.cost << " km" << endl;
+    cout << "Czas wykonania: " << duration_lk.count() << " ms" << endl;
+    cout << "Liczba iteracji: " << lk_iterations << endl;
+    displayMemory(memory_lk);
+    displayPerf(counters_lk);
 
     // Algorytm wyżarzania
     int sa_iterations;
     auto T = [](int iteration) -> double { return 10000.0 / iteration; }; // Funkcja temperatury
     auto start_sa = high_resolution_clock::now();
-    long mem_before_sa = getCurrentMemoryUsage();
-    Route saRoute = solve_simulated_annealing(distanceMatrix, T, maxIterations, sa_iterations);
-    long mem_after_sa = getCurrentMemoryUsage();
+    AllocationScope allocations_sa;
+    perf.start();
+    Route saRoute = solve_simulated_annealing(distanceMatrix, T, maxIterations, sa_iterations, neighborhood);
+    PerfReading counters_sa = perf.stop();
+    AllocationStats memory_sa = allocations_sa.stop();
     auto end_sa = high_resolution_clock::now();
     duration<double, milli> duration_sa = end_sa - start_sa;
 
@@ -125,23 +398,137 @@ int main(int argc, char* argv[]) {
     cout << "Koszt: " << saRoute.cost << " km" << endl;
     cout << "Czas wykonania: " << duration_sa.count() << " ms" << endl;
     cout << "Liczba iteracji: " << sa_iterations << endl;
-    cout << "Zużycie pamięci: " << (mem_after_sa - mem_before_sa) << " KB" << endl;
+    displayMemory(memory_sa);
+    displayPerf(counters_sa);
+
+    // Wyżarzanie z wymianą replik
+    int pt_iterations;
+    vector<ReplicaStats> replicaStats;
+    auto start_pt = high_resolution_clock::now();
+    AllocationScope allocations_pt;
+    perf.start();
+    Route ptRoute = solve_parallel_tempering(distanceMatrix, temperature_ladder(minTemperature, maxTemperature, replicas),
+                                             maxIterations, pt_iterations, replicaStats, 100, neighborhood, seed);
+    PerfReading counters_pt = perf.stop();
+    AllocationStats memory_pt = allocations_pt.stop();
+    auto end_pt = high_resolution_clock::now();
+    duration<double, milli> duration_pt = end_pt - start_pt;
+
+    cout << "\nTrasa po wyżarzaniu z wymianą replik (" << replicas << " replik):\n";
+    displayRoute(ptRoute.cities, cityNames);
+    cout << "Koszt: " << ptRoute.cost << " km" << endl;
+    cout << "Czas wykonania: " << duration_pt.count() << " ms" << endl;
+    cout << "Liczba iteracji: " << pt_iterations << endl;
+    displayMemory(memory_pt);
+    displayPerf(counters_pt);
+    for (const ReplicaStats& replica : replicaStats) {
+        cout << "  T = " << replica.temperature
+             << ": akceptacja " << 100.0 * replica.accepted / max(1LL, replica.proposed) << " %"
+             << ", wymiany " << replica.swapsAccepted << "/" << replica.swapAttempts << endl;
+    }
+
+    // Algorytm genetyczny (model wyspowy)
+    int ga_iterations;
+    auto start_ga = high_resolution_clock::now();
+    AllocationScope allocations_ga;
+    perf.start();
+    Route gaRoute = solve_genetic(distanceMatrix, populationSize, maxIterations, ga_iterations, crossover, 0.1, islands, 50, 2, seed);
+    PerfReading counters_ga = perf.stop();
+    AllocationStats memory_ga = allocations_ga.stop();
+    auto end_ga = high_resolution_clock::now();
+    duration<double, milli> duration_ga = end_ga - start_ga;
+
+    cout << "\nTrasa po algorytmie genetycznym:\n";
+    displayRoute(gaRoute.cities, cityNames);
+    cout << "Koszt: " << gaRoute.cost << " km" << endl;
+    cout << "Czas wykonania: " << duration_ga.count() << " ms" << endl;
+    cout << "Liczba iteracji: " << ga_iterations << endl;
+    displayMemory(memory_ga);
+    displayPerf(counters_ga);
+
+    // Algorytm mrówkowy (MAX-MIN Ant System)
+    int aco_iterations;
+    auto start_aco = high_resolution_clock::now();
+    AllocationScope allocations_aco;
+    perf.start();
+    Route acoRoute = solve_ant_colony(distanceMatrix, ants, maxIterations, aco_iterations, 3.0, 0.02, 15, seed);
+    PerfReading counters_aco = perf.stop();
+    AllocationStats memory_aco = allocations_aco.stop();
+    auto end_aco = high_resolution_clock::now();
+    duration<double, milli> duration_aco = end_aco - start_aco;
+
+    cout << "\nTrasa po algorytmie mrówkowym:\n";
+    displayRoute(acoRoute.cities, cityNames);
+    cout << "Koszt: " << acoRoute.cost << " km" << endl;
+    cout << "Czas wykonania: " << duration_aco.count() << " ms" << endl;
+    cout << "Liczba iteracji: " << aco_iterations << endl;
+    displayMemory(memory_aco);
+    displayPerf(counters_aco);
 
     // Algorytm pełnego przeglądu
-    int tsp_iterations;
-    auto start_tsp = high_resolution_clock::now();
-    long mem_before_tsp = getCurrentMemoryUsage();
-    Route bestRoute = solve_full_review(distanceMatrix, maxIterations, tsp_iterations);
-    long mem_after_tsp = getCurrentMemoryUsage();
-    auto end_tsp = high_resolution_clock::now();
-    duration<double, milli> duration_tsp = end_tsp - start_tsp;
-
-    cout << "\nTrasa po algorytmie pełnego przeglądu:\n";
-    displayRoute(bestRoute.cities, cityNames);
-    cout << "Koszt: " << bestRoute.cost << " km" << endl;
-    cout << "Czas wykonania: " << duration_tsp.count() << " ms" << endl;
-    cout << "Liczba iteracji: " << tsp_iterations << endl;
-    cout << "Zużycie pamięci: " << (mem_after_tsp - mem_before_tsp) << " KB" << endl;
+    if (distanceMatrix.size() <= FULL_REVIEW_MAX_CITIES) {
+        int tsp_iterations;
+        auto start_tsp = high_resolution_clock::now();
+        AllocationScope allocations_tsp;
+        perf.start();
+        Route bestRoute = solve_full_review(distanceMatrix, maxIterations, tsp_iterations);
+        PerfReading counters_tsp = perf.stop();
+        AllocationStats memory_tsp = allocations_tsp.stop();
+        auto end_tsp = high_resolution_clock::now();
+        duration<double, milli> duration_tsp = end_tsp - start_tsp;
+
+        cout << "\nTrasa po algorytmie pełnego przeglądu:\n";
+        displayRoute(bestRoute.cities, cityNames);
+        cout << "Koszt: " << bestRoute.cost << " km" << endl;
+        cout << "Czas wykonania: " << duration_tsp.count() << " ms" << endl;
+        cout << "Liczba iteracji: " << tsp_iterations << endl;
+        displayMemory(memory_tsp);
+        displayPerf(counters_tsp);
+    }
+
+    // Algorytm Helda-Karpa (programowanie dynamiczne)
+    if (distanceMatrix.size() <= HELD_KARP_MAX_CITIES) {
+        int hk_iterations;
+        auto start_hk = high_resolution_clock::now();
+        AllocationScope allocations_hk;
+        perf.start();
+        Route heldKarpRoute = solve_held_karp(distanceMatrix, hk_iterations);
+        PerfReading counters_hk = perf.stop();
+        AllocationStats memory_hk = allocations_hk.stop();
+        auto end_hk = high_resolution_clock::now();
+        duration<double, milli> duration_hk = end_hk - start_hk;
+
+        cout << "\nTrasa po algorytmie Helda-Karpa:\n";
+        displayRoute(heldKarpRoute.cities, cityNames);
+        cout << "Koszt: " << heldKarpRoute.cost << " km" << endl;
+        cout << "Czas wykonania: " << duration_hk.count() << " ms" << endl;
+        cout << "Liczba iteracji: " << hk_iterations << endl;
+        displayMemory(memory_hk);
+        displayPerf(counters_hk);
+    }
+
+    // Metoda podziału i ograniczeń (1-drzewa z karami Lagrange'a)
+    if (distanceMatrix.size() <= BRANCH_AND_BOUND_MAX_CITIES) {
+        int bb_iterations;
+        double bb_gap;
+        auto start_bb = high_resolution_clock::now();
+        AllocationScope allocations_bb;
+        perf.start();
+        Route branchAndBoundRoute = solve_branch_and_bound(distanceMatrix, timeLimit, bb_iterations, bb_gap);
+        PerfReading counters_bb = perf.stop();
+        AllocationStats memory_bb = allocations_bb.stop();
+        auto end_bb = high_resolution_clock::now();
+        duration<double, milli> duration_bb = end_bb - start_bb;
+
+        cout << "\nTrasa po metodzie podziału i ograniczeń:\n";
+        displayRoute(branchAndBoundRoute.cities, cityNames);
+        cout << "Koszt: " << branchAndBoundRoute.cost << " km" << endl;
+        cout << "Luka optymalności: " << bb_gap * 100.0 << " %" << endl;
+        cout << "Czas wykonania: " << duration_bb.count() << " ms" << endl;
+        cout << "Liczba iteracji: " << bb_iterations << endl;
+        displayMemory(memory_bb);
+        displayPerf(counters_bb);
+    }
 
     return 0;
 }
@@ -0,0 +1,33 @@
+#include <iostream>
+#include <string>
+#include "tsp.h"
+#include "binary_matrix.h"
+
+using namespace std;
+
+// Konwerter instancji do formatu binarnego: matrix_to_bin <instancja> [plik.tspbin]
+// Wejście to dowolny format obsługiwany przez read_instance (CSV, TSPLIB, dane.txt).
+// Domyślnie plik wynikowy ma tę samą nazwę z rozszerzeniem .tspbin.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Użycie: " << argv[0] << " <instancja> [plik.tspbin]" << endl;
+        return 1;
+    }
+    string inputPath = argv[1];
+    string outputPath;
+    if (argc > 2) {
+        outputPath = argv[2];
+    } else {
+        size_t dot = inputPath.rfind('.');
+        outputPath = (dot == string::npos ? inputPath : inputPath.substr(0, dot)) + ".tspbin";
+    }
+
+    auto [cityNames, distanceMatrix] = read_instance(inputPath);
+    if (!write_binary_matrix(outputPath, cityNames, distanceMatrix)) {
+        return 1;
+    }
+    // Kontrola zapisanego pliku (łącznie z sumą kontrolną)
+    auto [mappedNames, mappedMatrix] = map_binary_matrix(outputPath, true);
+    cout << outputPath << ": " << mappedMatrix.size() << " miast" << endl;
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "tsp.h"
+#include "candidate_list.h"
+#include "shared_best.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Wielostartowe przeszukiwanie lokalne. Wątki pobierają numery startów ze
+// wspólnego licznika; na czas startu generator wątku dostaje ziarno
+// z (seed, numer startu). Wynik każdego startu zgłaszany jest do wspólnej
+// najlepszej trasy. Przeszukiwania sprawdzają wspólny warunek stop: gdy
+// którykolwiek start osiągnie targetCost, przerywane są wszystkie.
+Route solve_multi_start(const DistanceMatrix& distanceMatrix, int starts, int maxIterations, int& iteration_count,
+                        bool randomNeighbor, ImprovementStrategy strategy, NeighborhoodType neighborhood,
+                        int candidates, double targetCost, unsigned seed, int threads) {
+    int numberOfCities = distanceMatrix.size();
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    if (starts <= 0) {
+        starts = threads;
+    }
+    CandidateList candidateList;
+    if (candidates > 0 && !randomNeighbor) {
+        candidateList = CandidateList(distanceMatrix, candidates);
+    }
+
+    SharedBest shared({{}, numeric_limits<double>::infinity()}, "multi_start");
+    atomic<int> nextStart(0);
+    atomic<long long> iterations(0);
+    StopCondition stop(targetCost);
+
+    auto work = [&]() {
+        for (int start = nextStart++; start < starts && !stop.reached(shared.cost()); start = nextStart++) {
+            RandomStream stream(seed, start);
+
+            Route route = generate_random_solution(numberOfCities, distanceMatrix);
+            int startIterations = 0;
+            if (randomNeighbor) {
+                improve_random_hill_climbing(route, distanceMatrix, maxIterations, startIterations, nullptr, &stop);
+            } else {
+                improve_hill_climbing(route, distanceMatrix, maxIterations, startIterations, strategy, neighborhood,
+                                      candidates > 0 ? &candidateList : nullptr, nullptr, &stop);
+            }
+            iterations += startIterations;
+            shared.offer(route.cities, route.cost, start + 1);
+        }
+    };
+
+    int workers = min(threads, starts);
+    if (workers <= 1) {
+        work();
+    } else {
+        vector<thread> pool;
+        for (int t = 0; t < workers; ++t) {
+            pool.emplace_back(work);
+        }
+        for (auto& worker : pool) {
+            worker.join();
+        }
+    }
+
+    iteration_count = static_cast<int>(min<long long>(iterations, numeric_limits<int>::max()));
+    return shared.best();
+}
@@ -0,0 +1,130 @@
+#include "tsp.h"
+#include "barrier.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Stan repliki: bieżąca trasa przy danej temperaturze (trasy wędrują między
+// temperaturami przy wymianach) i najlepsza trasa widziana przez tę replikę.
+// Wyrównanie do linii pamięci podręcznej - repliki nie współdzielą linii.
+struct alignas(64) Replica {
+    Route route;
+    Route best;
+};
+
+} // namespace
+
+vector<double> temperature_ladder(double minTemperature, double maxTemperature, int replicas) {
+    vector<double> temperatures(max(1, replicas), minTemperature);
+    for (int k = 1; k < replicas; ++k) {
+        temperatures[k] = minTemperature * pow(maxTemperature / minTemperature, static_cast<double>(k) / (replicas - 1));
+    }
+    return temperatures;
+}
+
+// Wyżarzanie z wymianą replik (parallel tempering). Replika k działa we własnym
+// wątku w stałej temperaturze temperatures[k] (kryterium Metropolisa jak
+// w solve_simulated_annealing). Co swapInterval iteracji wątki spotykają się na
+// barierze i sąsiednie temperatury (na przemian pary parzyste i nieparzyste)
+// wymieniają trasy z prawdopodobieństwem
+// min(1, exp((E_k - E_{k+1}) * (1/T_k - 1/T_{k+1}))).
+Route solve_parallel_tempering(const DistanceMatrix& distanceMatrix, const vector<double>& temperatures, int maxIterations,
+                               int& iteration_count, vector<ReplicaStats>& stats, int swapInterval,
+                               NeighborhoodType neighborhood, unsigned seed) {
+    int numberOfCities = distanceMatrix.size();
+    int replicas = temperatures.size();
+    swapInterval = max(1, swapInterval);
+    iteration_count = 0;
+    stats.assign(replicas, ReplicaStats());
+    for (int k = 0; k < replicas; ++k) {
+        stats[k].temperature = temperatures[k];
+    }
+
+    if (replicas == 0 || numberOfCities <= 2) {
+        return generate_random_solution(numberOfCities, distanceMatrix);
+    }
+    vector<Replica> states(replicas);
+
+    Trace trace("parallel_tempering");
+
+    // Faza wymian - wykonywana przez ostatni wątek przybywający na barierę
+    seed_seq swapSeed{seed, static_cast<unsigned>(replicas)};
+    mt19937 swapGenerator(swapSeed);
+    uniform_real_distribution<double> u(0.0, 1.0);
+    int round = 0;
+    auto exchange = [&]() {
+        for (int k = round % 2; k + 1 < replicas; k += 2) {
+            double energyDifference = states[k].route.cost - states[k + 1].route.cost;
+            double betaDifference = 1.0 / temperatures[k] - 1.0 / temperatures[k + 1];
+            stats[k].swapAttempts++;
+            if (u(swapGenerator) < exp(energyDifference * betaDifference)) {
+                swap(states[k].route, states[k + 1].route);
+                stats[k].swapsAccepted++;
+            }
+        }
+        ++round;
+        double best = states[0].best.cost;
+        for (const Replica& replica : states) {
+            best = min(best, replica.best.cost);
+        }
+        trace.record(static_cast<long long>(round) * swapInterval, best);
+    };
+    Barrier barrier(replicas, exchange);
+
+    auto work = [&](int k) {
+        RandomStream stream(seed, k);
+        mt19937& rgen = random_engine();
+        uniform_real_distribution<double> acceptance(0.0, 1.0);
+        Replica& replica = states[k];
+        replica.route = generate_random_solution(numberOfCities, distanceMatrix);
+        replica.best = replica.route;
+        double temperature = temperatures[k];
+        long long proposed = 0;
+        long long accepted = 0;
+        for (int done = 0; done < maxIterations;) {
+            int chunk = min(swapInterval, maxIterations - done);
+            for (int i = 0; i < chunk; ++i) {
+                Move move = random_move(replica.route, distanceMatrix, rgen, neighborhood);
+                proposed++;
+                if (move.delta < 0.0 || acceptance(rgen) < exp(-abs(move.delta) / temperature)) {
+                    apply_move(replica.route, move);
+                    accepted++;
+                    if (replica.route.cost < replica.best.cost) {
+                        replica.best = replica.route;
+                    }
+                }
+            }
+            done += chunk;
+            // Wszystkie repliki wykonują tyle samo rund, więc spotykają się zawsze
+            barrier.arrive_and_wait();
+        }
+        stats[k].proposed = proposed;
+        stats[k].accepted = accepted;
+    };
+
+    vector<thread> pool;
+    for (int k = 0; k < replicas; ++k) {
+        pool.emplace_back(work, k);
+    }
+    for (auto& worker : pool) {
+        worker.join();
+    }
+
+    Route bestRoute = states[0].best;
+    for (const Replica& replica : states) {
+        if (replica.best.cost < bestRoute.cost) {
+            bestRoute = replica.best;
+        }
+    }
+    iteration_count = static_cast<int>(min<long long>(static_cast<long long>(maxIterations) * replicas, numeric_limits<int>::max()));
+    return bestRoute;
+}
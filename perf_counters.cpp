@@ -0,0 +1,162 @@
+#include "perf_counters.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+double PerfReading::ipc() const {
+    if (!has(PerfEvent::Cycles) || !has(PerfEvent::Instructions) || (*this)[PerfEvent::Cycles] == 0) {
+        return 0.0;
+    }
+    return static_cast<double>((*this)[PerfEvent::Instructions]) / (*this)[PerfEvent::Cycles];
+}
+
+#ifdef __linux__
+
+namespace {
+
+// Typ i konfiguracja zdarzenia perf dla każdego z liczników
+void describe(PerfEvent event, perf_event_attr& attr) {
+    auto cache = [](uint64_t cache, uint64_t op, uint64_t result) { return cache | (op << 8) | (result << 16); };
+    switch (event) {
+    case PerfEvent::Cycles:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PerfEvent::Instructions:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PerfEvent::L1dMisses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+        break;
+    case PerfEvent::LlcMisses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    case PerfEvent::BranchMisses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case PerfEvent::Count:
+        break;
+    }
+}
+
+int open_counter(PerfEvent event) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    describe(event, attr);
+    attr.disabled = 1;
+    attr.inherit = 1;  // wątki algorytmu tworzone w trakcie pomiaru
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters(bool enabled) {
+    for (int& descriptor : descriptors) {
+        descriptor = -1;
+    }
+    if (!enabled) {
+        return;
+    }
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        descriptors[e] = open_counter(static_cast<PerfEvent>(e));
+        if (descriptors[e] < 0 && openError.empty()) {
+            openError = strerror(errno);
+        }
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int descriptor : descriptors) {
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+    }
+}
+
+// Odczyt licznika: wartość, czas włączenia, czas faktycznego liczenia
+bool PerfCounters::read_counter(int e, uint64_t (&data)[3]) const {
+    return descriptors[e] >= 0 && read(descriptors[e], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data));
+}
+
+// Wynik to różnica odczytów z końca i początku pomiaru - PERF_EVENT_IOC_RESET nie
+// zeruje wartości przejętych od zakończonych wątków potomnych
+void PerfCounters::start() {
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        if (!read_counter(e, baseline[e])) {
+            baseline[e][0] = baseline[e][1] = baseline[e][2] = 0;
+        }
+        if (descriptors[e] >= 0) {
+            ioctl(descriptors[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+PerfReading PerfCounters::stop() {
+    PerfReading reading;
+    for (int descriptor : descriptors) {
+        if (descriptor >= 0) {
+            ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int e = 0; e < PERF_EVENT_COUNT; ++e) {
+        uint64_t data[3];
+        if (!read_counter(e, data)) {
+            continue;
+        }
+        uint64_t value = data[0] - baseline[e][0];
+        uint64_t enabled = data[1] - baseline[e][1];
+        uint64_t running = data[2] - baseline[e][2];
+        if (running == 0) {
+            continue;
+        }
+        // Przy multipleksowaniu liczników wynik jest skalowany do pełnego czasu pomiaru
+        double scale = running < enabled ? static_cast<double>(enabled) / running : 1.0;
+        reading.values[e] = static_cast<uint64_t>(value * scale);
+        reading.available[e] = true;
+    }
+    return reading;
+}
+
+#else
+
+PerfCounters::PerfCounters(bool enabled) {
+    for (int& descriptor : descriptors) {
+        descriptor = -1;
+    }
+    if (enabled) {
+        openError = "perf_event_open jest dostępne tylko w systemie Linux";
+    }
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+PerfReading PerfCounters::stop() { return {}; }
+
+#endif
+
+bool PerfCounters::available() const {
+    for (int descriptor : descriptors) {
+        if (descriptor >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,63 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// Sprzętowe liczniki wydajności (Linux perf_event_open) dla jednego odcinka
+// programu. Liczone są wątki procesu, także tworzone przez algorytm w trakcie
+// pomiaru (inherit). Licznik, którego nie udało się otworzyć (brak uprawnień -
+// perf_event_paranoid, maszyna wirtualna, inny system), jest pomijany, a
+// pozostałe działają dalej.
+
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    L1dMisses,     // chybienia odczytu pamięci podręcznej danych L1
+    LlcMisses,     // chybienia ostatniego poziomu pamięci podręcznej
+    BranchMisses,  // błędnie przewidziane skoki
+    Count
+};
+
+constexpr int PERF_EVENT_COUNT = static_cast<int>(PerfEvent::Count);
+
+struct PerfReading {
+    uint64_t values[PERF_EVENT_COUNT] = {};
+    bool available[PERF_EVENT_COUNT] = {};
+
+    bool has(PerfEvent event) const { return available[static_cast<int>(event)]; }
+    uint64_t operator[](PerfEvent event) const { return values[static_cast<int>(event)]; }
+
+    // Instrukcje na cykl (0, gdy brak któregoś z liczników)
+    double ipc() const;
+};
+
+class PerfCounters {
+public:
+    // enabled == false - liczniki nie są otwierane, stop() zwraca pusty odczyt
+    explicit PerfCounters(bool enabled);
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Czy działa przynajmniej jeden licznik
+    bool available() const;
+
+    // Opis błędu otwarcia liczników (pusty, gdy wszystkie działają)
+    const string& error() const { return openError; }
+
+    void start();
+    PerfReading stop();
+
+private:
+    bool read_counter(int e, uint64_t (&data)[3]) const;
+
+    int descriptors[PERF_EVENT_COUNT];
+    uint64_t baseline[PERF_EVENT_COUNT][3] = {};
+    string openError;
+};
+
+#endif // PERF_COUNTERS_H
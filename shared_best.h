@@ -0,0 +1,49 @@
+#ifndef SHARED_BEST_H
+#define SHARED_BEST_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "tsp.h"
+#include "trace.h"
+
+using namespace std;
+
+// Najlepsza trasa wspólna dla wielu wątków. Koszt jest czytany bez blokady
+// (odcinanie, warunek stopu), trasa i ślad kolejnych popraw są chronione muteksem.
+class SharedBest {
+public:
+    SharedBest(Route route, const string& traceName)
+        : bestRoute(move(route)), bestCost(bestRoute.cost), trace(traceName) {}
+
+    double cost() const { return bestCost.load(memory_order_relaxed); }
+
+    // true, jeśli trasa poprawiła najlepszą
+    bool offer(const vector<int>& cities, double cost, long long iteration) {
+        if (cost >= this->cost()) {
+            return false;
+        }
+        lock_guard<mutex> lock(guard);
+        if (cost >= bestRoute.cost) {
+            return false;
+        }
+        bestRoute = {cities, cost};
+        bestCost.store(cost, memory_order_relaxed);
+        trace.record(iteration, cost);
+        return true;
+    }
+
+    Route best() {
+        lock_guard<mutex> lock(guard);
+        return bestRoute;
+    }
+
+private:
+    mutex guard;
+    Route bestRoute;
+    atomic<double> bestCost;
+    Trace trace;
+};
+
+#endif // SHARED_BEST_H
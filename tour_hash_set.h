@@ -0,0 +1,74 @@
+#ifndef TOUR_HASH_SET_H
+#define TOUR_HASH_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Zbiór skrótów tras (Route::hash) z adresowaniem otwartym i sondowaniem
+// liniowym. Wartość 0 oznacza pusty slot, więc skrót 0 zapisywany jest jako 1.
+// Tablica podwaja się, gdy zapełnienie przekroczy połowę.
+class TourHashSet {
+public:
+    explicit TourHashSet(size_t expected = 1024) : slots(capacity_for(expected), 0) {}
+
+    size_t size() const { return count; }
+
+    bool contains(uint64_t hash) const {
+        hash = stored(hash);
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask; slots[i] != 0; i = (i + 1) & mask) {
+            if (slots[i] == hash) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // false, jeśli skrót już był w zbiorze
+    bool insert(uint64_t hash) {
+        if (2 * (count + 1) > slots.size()) {
+            grow();
+        }
+        hash = stored(hash);
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        for (; slots[i] != 0; i = (i + 1) & mask) {
+            if (slots[i] == hash) {
+                return false;
+            }
+        }
+        slots[i] = hash;
+        ++count;
+        return true;
+    }
+
+private:
+    static uint64_t stored(uint64_t hash) { return hash == 0 ? 1 : hash; }
+
+    static size_t capacity_for(size_t expected) {
+        size_t capacity = 16;
+        while (capacity < 2 * expected) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    void grow() {
+        vector<uint64_t> old(2 * slots.size(), 0);
+        old.swap(slots);
+        count = 0;
+        for (uint64_t hash : old) {
+            if (hash != 0) {
+                insert(hash);
+            }
+        }
+    }
+
+    vector<uint64_t> slots;
+    size_t count = 0;
+};
+
+#endif // TOUR_HASH_SET_H
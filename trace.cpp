@@ -0,0 +1,123 @@
+#include "trace.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+TraceOptions options;
+
+// Numer kolejnego śladu w procesie - rozróżnia pliki śladów o tej samej nazwie
+atomic<int> traceSequence{0};
+
+} // namespace
+
+void set_trace_options(const TraceOptions& newOptions) {
+    options = newOptions;
+    options.every = max(1LL, options.every);
+}
+
+const TraceOptions& trace_options() {
+    return options;
+}
+
+Trace::Trace(const string& name, TraceDirection direction) : direction(direction) {
+    if (!options.enabled) {
+        return;
+    }
+    filePath = options.directory + "/" + name + "." + to_string(getpid()) + "." + to_string(traceSequence++) + ".trace";
+    file = fopen(filePath.c_str(), "wb");
+    if (!file) {
+        cerr << "Nie można utworzyć pliku śladu: " << filePath << endl;
+        filePath.clear();
+        return;
+    }
+    uint32_t header[2] = {TRACE_VERSION, sizeof(TraceRecord)};
+    fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), file);
+    fwrite(header, sizeof(uint32_t), 2, file);
+
+    size_t capacity = 2;
+    while (capacity < options.bufferRecords) {
+        capacity *= 2;
+    }
+    buffer.resize(capacity);
+    mask = capacity - 1;
+    sampling = options.sampling;
+    every = options.every;
+    active = true;
+    flusher = thread(&Trace::flush_loop, this);
+}
+
+Trace::~Trace() {
+    if (!active) {
+        return;
+    }
+    stopping = true;
+    dataReady.notify_one();
+    flusher.join();
+    fclose(file);
+}
+
+// Zapis wszystkich rekordów dostępnych w buforze - w jednym lub dwóch
+// ciągłych kawałkach (gdy zawartość zawija się na końcu bufora)
+void Trace::drain() {
+    lock_guard<mutex> lock(fileGuard);
+    size_t t = tail.load(memory_order_relaxed);
+    size_t h = head.load(memory_order_acquire);
+    while (t != h) {
+        size_t begin = t & mask;
+        size_t count = min(h - t, buffer.size() - begin);
+        fwrite(buffer.data() + begin, sizeof(TraceRecord), count, file);
+        t += count;
+        tail.store(t, memory_order_release);
+    }
+}
+
+void Trace::flush_loop() {
+    while (!stopping) {
+        {
+            unique_lock<mutex> lock(guard);
+            dataReady.wait_for(lock, chrono::milliseconds(10));
+        }
+        drain();
+    }
+    drain();
+    fflush(file);
+}
+
+bool convert_trace_to_csv(const string& tracePath, const string& csvPath) {
+    ifstream input(tracePath, ios::binary);
+    if (!input) {
+        cerr << "Nie można otworzyć pliku śladu: " << tracePath << endl;
+        return false;
+    }
+    char magic[sizeof(TRACE_MAGIC)];
+    uint32_t header[2];
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!input || memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0 || header[0] != TRACE_VERSION
+        || header[1] != sizeof(TraceRecord)) {
+        cerr << "Niepoprawny plik śladu: " << tracePath << endl;
+        return false;
+    }
+
+    ofstream output(csvPath);
+    if (!output) {
+        cerr << "Nie można utworzyć pliku: " << csvPath << endl;
+        return false;
+    }
+    output << "Iteration,Cost\n";  // Nagłówki kolumn
+    vector<TraceRecord> chunk(4096);
+    while (input) {
+        input.read(reinterpret_cast<char*>(chunk.data()), chunk.size() * sizeof(TraceRecord));
+        size_t count = input.gcount() / sizeof(TraceRecord);
+        for (size_t i = 0; i < count; ++i) {
+            output << chunk[i].iteration << "," << chunk[i].cost << "\n";
+        }
+    }
+    return static_cast<bool>(output);
+}
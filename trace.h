@@ -0,0 +1,130 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Zapis przebiegu zbieżności algorytmów (iteracja, koszt). Domyślnie wyłączony -
+// Trace nie otwiera wtedy pliku ani nie uruchamia wątku, a record() kończy się
+// na jednym sprawdzeniu flagi.
+
+// Rekord pliku śladu
+struct TraceRecord {
+    int64_t iteration;
+    double cost;
+};
+
+enum class TraceSampling {
+    EveryK,       // co every-tą iterację
+    Improvements  // tylko gdy wartość poprawiła najlepszą zapisaną
+};
+
+// Kierunek poprawy śladu przy próbkowaniu Improvements: koszt trasy maleje,
+// a np. ograniczenie dolne metody podziału i ograniczeń rośnie
+enum class TraceDirection {
+    Minimize,
+    Maximize
+};
+
+struct TraceOptions {
+    bool enabled = false;
+    string directory = ".";
+    TraceSampling sampling = TraceSampling::EveryK;
+    long long every = 1;
+    size_t bufferRecords = 1 << 16;  // pojemność bufora cyklicznego (zaokrąglana w górę do potęgi 2)
+};
+
+// Ustawienia globalne - zmieniane w main przed uruchomieniem algorytmów
+void set_trace_options(const TraceOptions& options);
+
+const TraceOptions& trace_options();
+
+// Ślad jednego przebiegu algorytmu. Rekordy trafiają do prealokowanego bufora
+// cyklicznego, a wątek w tle dopisuje je do pliku binarnego
+// <katalog>/<name>.<pid>.<numer>.trace: nagłówek TRACE_MAGIC, wersja, rozmiar
+// rekordu, a dalej kolejne TraceRecord. Jeden producent naraz - wywołania
+// record() z różnych wątków muszą być uszeregowane (np. muteksem lub barierą).
+// Gdy bufor jest pełny, record() sam zapisuje jego zawartość do pliku.
+class Trace {
+public:
+    explicit Trace(const string& name, TraceDirection direction = TraceDirection::Minimize);
+    ~Trace();
+
+    Trace(const Trace&) = delete;
+    Trace& operator=(const Trace&) = delete;
+
+    bool enabled() const { return active; }
+
+    // Ścieżka pliku śladu (pusta, gdy ślad jest wyłączony)
+    const string& path() const { return filePath; }
+
+    void record(long long iteration, double cost) {
+        if (!active) {
+            return;
+        }
+        if (sampling == TraceSampling::Improvements) {
+            // Dla Maximize porównywane są wartości z przeciwnym znakiem
+            double value = direction == TraceDirection::Minimize ? cost : -cost;
+            if (!(value < bestValue)) {
+                return;
+            }
+            bestValue = value;
+        } else if (iteration % every != 0) {
+            return;
+        }
+        push({iteration, cost});
+    }
+
+private:
+    void push(const TraceRecord& traceRecord) {
+        size_t h = head.load(memory_order_relaxed);
+        if (h - tail.load(memory_order_acquire) == buffer.size()) {
+            drain();
+        }
+        buffer[h & mask] = traceRecord;
+        head.store(h + 1, memory_order_release);
+        if (h + 1 - tail.load(memory_order_relaxed) == buffer.size() / 2) {
+            dataReady.notify_one();
+        }
+    }
+
+    void flush_loop();
+    void drain();
+
+    bool active = false;
+    TraceSampling sampling = TraceSampling::EveryK;
+    long long every = 1;
+    TraceDirection direction = TraceDirection::Minimize;
+    double bestValue = numeric_limits<double>::infinity();
+
+    vector<TraceRecord> buffer;
+    size_t mask = 0;
+    atomic<size_t> head{0};
+    atomic<size_t> tail{0};
+    atomic<bool> stopping{false};
+
+    mutex guard;         // oczekiwanie wątku zapisu na dane
+    mutex fileGuard;     // zapis do pliku i przesuwanie tail
+    condition_variable dataReady;
+    thread flusher;
+    FILE* file = nullptr;
+    string filePath;
+};
+
+// Nagłówek pliku śladu
+constexpr char TRACE_MAGIC[8] = {'T', 'S', 'P', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t TRACE_VERSION = 1;
+
+// Konwersja pliku śladu do CSV (Iteration,Cost); false przy błędzie odczytu lub zapisu
+bool convert_trace_to_csv(const string& tracePath, const string& csvPath);
+
+#endif // TRACE_H
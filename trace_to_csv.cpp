@@ -0,0 +1,23 @@
+#include <iostream>
+#include <string>
+#include "trace.h"
+
+using namespace std;
+
+// Konwerter plików śladu: trace_to_csv <plik.trace> [plik.csv]
+// Domyślnie plik CSV ma tę samą nazwę z rozszerzeniem .csv zamiast .trace.
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Użycie: " << argv[0] << " <plik.trace> [plik.csv]" << endl;
+        return 1;
+    }
+    string tracePath = argv[1];
+    string csvPath;
+    if (argc > 2) {
+        csvPath = argv[2];
+    } else {
+        size_t dot = tracePath.rfind(".trace");
+        csvPath = (dot == string::npos ? tracePath : tracePath.substr(0, dot)) + ".csv";
+    }
+    return convert_trace_to_csv(tracePath, csvPath) ? 0 : 1;
+}
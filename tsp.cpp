@@ -1,4 +1,9 @@
 #include "tsp.h"
+#include "dont_look_bits.h"
+#include "tour_hash_set.h"
+#include "trace.h"
+#include "tsplib.h"
+#include "binary_matrix.h"
 #include <algorithm>
 #include <numeric>
 #include <random>
@@ -8,234 +13,893 @@
 #include <iostream>
 #include <deque>
 #include <unordered_set>
-#include <list>
-#include <set>
 #include <cmath>
 
 using namespace std;
 
 // Funkcja celu
-double check_cost(const vector<int>& route, const vector<vector<double>>& distanceMatrix) {
+template <typename Distances>
+double check_cost(const vector<int>& route, const Distances& distanceMatrix) {
     double totalCost = 0.0;
     for (size_t i = 0; i < route.size() - 1; ++i) {
-        totalCost += distanceMatrix[route[i]][route[i + 1]];
+        totalCost += distanceMatrix(route[i], route[i + 1]);
     }
-    totalCost += distanceMatrix[route.back()][route.front()];
+    totalCost += distanceMatrix(route.back(), route.front());
     return totalCost;
 }
 
+// Zmiana kosztu trasy po zamianie miast na pozycjach i oraz j - liczona w O(1)
+// z krawędzi wokół obu pozycji, bez przeliczania całej trasy
+template <typename Distances>
+double swap_delta(const vector<int>& route, int i, int j, const Distances& distanceMatrix) {
+    int n = route.size();
+    if (n < 3 || i == j) {
+        return 0.0;
+    }
+    if (i > j) {
+        swap(i, j);
+    }
+    int a = route[i];
+    int b = route[j];
+    int prevA = route[(i + n - 1) % n];
+    int nextA = route[(i + 1) % n];
+    int prevB = route[(j + n - 1) % n];
+    int nextB = route[(j + 1) % n];
+
+    if (j == i + 1) {
+        // prevA -> a -> b -> nextB  =>  prevA -> b -> a -> nextB
+        return distanceMatrix(prevA, b) + distanceMatrix(b, a) + distanceMatrix(a, nextB)
+             - distanceMatrix(prevA, a) - distanceMatrix(a, b) - distanceMatrix(b, nextB);
+    }
+    if (i == 0 && j == n - 1) {
+        // prevB -> b -> a -> nextA  =>  prevB -> a -> b -> nextA
+        return distanceMatrix(prevB, a) + distanceMatrix(a, b) + distanceMatrix(b, nextA)
+             - distanceMatrix(prevB, b) - distanceMatrix(b, a) - distanceMatrix(a, nextA);
+    }
+    return distanceMatrix(prevA, b) + distanceMatrix(b, nextA) + distanceMatrix(prevB, a) + distanceMatrix(a, nextB)
+         - distanceMatrix(prevA, a) - distanceMatrix(a, nextA) - distanceMatrix(prevB, b) - distanceMatrix(b, nextB);
+}
+
+// Zmiana kosztu po odwróceniu fragmentu trasy [i, j] (ruch 2-opt): krawędzie
+// (prev, a) i (b, next) zastępowane są przez (prev, b) i (a, next). Dla macierzy
+// symetrycznej koszt jest O(1); dla niesymetrycznej dochodzi różnica kosztu
+// przejścia fragmentu w przeciwnym kierunku.
+template <typename Distances>
+double two_opt_delta(const vector<int>& route, int i, int j, const Distances& distanceMatrix) {
+    int n = route.size();
+    if (n < 3 || i == j) {
+        return 0.0;
+    }
+    if (i > j) {
+        swap(i, j);
+    }
+    int a = route[i];
+    int b = route[j];
+    int prev = route[(i + n - 1) % n];
+    int next = route[(j + 1) % n];
+
+    double delta = distanceMatrix(prev, b) + distanceMatrix(a, next)
+                 - distanceMatrix(prev, a) - distanceMatrix(b, next);
+    if (!distanceMatrix.symmetric()) {
+        for (int k = i; k < j; ++k) {
+            delta += distanceMatrix(route[k + 1], route[k]) - distanceMatrix(route[k], route[k + 1]);
+        }
+    }
+    return delta;
+}
+
+// Zmiana kosztu po przeniesieniu fragmentu [i, j] (a ... b) za pozycję k (u, v):
+// krawędzie (prev, a), (b, next), (u, v) zastępowane są przez (prev, next),
+// (u, a), (b, v) lub - dla fragmentu odwróconego - (u, b), (a, v).
+// Bez odwracania koszt jest O(1) także dla macierzy niesymetrycznej.
+template <typename Distances>
+double segment_move_delta(const vector<int>& route, int i, int j, int k, bool reversed, const Distances& distanceMatrix) {
+    int n = route.size();
+    int a = route[i];
+    int b = route[j];
+    int prev = route[(i + n - 1) % n];
+    int next = route[(j + 1) % n];
+    int u = route[k];
+    int v = route[(k + 1) % n];
+
+    double delta = distanceMatrix(prev, next) - distanceMatrix(prev, a) - distanceMatrix(b, next) - distanceMatrix(u, v);
+    if (!reversed) {
+        return delta + distanceMatrix(u, a) + distanceMatrix(b, v);
+    }
+    delta += distanceMatrix(u, b) + distanceMatrix(a, v);
+    if (!distanceMatrix.symmetric()) {
+        for (int t = i; t < j; ++t) {
+            delta += distanceMatrix(route[t + 1], route[t]) - distanceMatrix(route[t], route[t + 1]);
+        }
+    }
+    return delta;
+}
+
+// Ocena ruchu: uzupełnia zmianę kosztu dla ruchu o podanych pozycjach
+template <typename Distances>
+Move evaluate_move(const Route& route, Move move, const Distances& distanceMatrix) {
+    switch (move.type) {
+        case NeighborhoodType::Swap:
+            move.delta = swap_delta(route.cities, move.i, move.j, distanceMatrix);
+            break;
+        case NeighborhoodType::TwoOpt:
+            move.delta = two_opt_delta(route.cities, move.i, move.j, distanceMatrix);
+            break;
+        case NeighborhoodType::OrOpt:
+        case NeighborhoodType::ThreeOpt:
+            move.delta = segment_move_delta(route.cities, move.i, move.j, move.k, move.reversed, distanceMatrix);
+            break;
+    }
+    return move;
+}
+
+template <typename Distances>
+BasicNeighborhood<Distances>::BasicNeighborhood(const Route& route, const Distances& distanceMatrix, NeighborhoodType type,
+                                                const CandidateList* candidates)
+    : route(route), distanceMatrix(distanceMatrix), type(type), candidates(candidates),
+      lastBase(static_cast<int>(route.cities.size()) - 1) {
+    if (candidates) {
+        ownPositions.resize(route.cities.size());
+        for (size_t i = 0; i < route.cities.size(); ++i) {
+            ownPositions[route.cities[i]] = i;
+        }
+    }
+}
+
+template <typename Distances>
+BasicNeighborhood<Distances>::BasicNeighborhood(const Route& route, const Distances& distanceMatrix, NeighborhoodType type,
+                                                const CandidateList& candidates, const vector<int>& positions, int baseCity)
+    : route(route), distanceMatrix(distanceMatrix), type(type), candidates(&candidates),
+      externalPositions(&positions), firstBase(positions[baseCity]), lastBase(positions[baseCity]) {}
+
+// Liczba wariantów ruchu na parę (miasto, kandydat)
+template <typename Distances>
+int BasicNeighborhood<Distances>::variants() const {
+    switch (type) {
+        case NeighborhoodType::Swap:
+        case NeighborhoodType::TwoOpt:
+            return 2;  // nowa krawędź po stronie następnika lub poprzednika
+        case NeighborhoodType::OrOpt:
+            return 4 * OR_OPT_MAX_SEGMENT;  // długość x (początek/koniec fragmentu) x (za/przed kandydatem)
+        case NeighborhoodType::ThreeOpt:
+            return candidates->k();  // kandydat dla drugiej nowej krawędzi
+    }
+    return 0;
+}
+
+template <typename Distances>
+Move BasicNeighborhood<Distances>::iterator::operator*() const {
+    return evaluate_move(owner->route, position, owner->distanceMatrix);
+}
+
+// Kolejna pozycja w porządku leksykograficznym (bez sprawdzania poprawności)
+template <typename Distances>
+void BasicNeighborhood<Distances>::iterator::step() {
+    if (owner->candidates) {
+        step_candidates();
+        return;
+    }
+    int n = owner->route.cities.size();
+    Move& m = position;
+    switch (owner->type) {
+        case NeighborhoodType::Swap:
+        case NeighborhoodType::TwoOpt:
+            if (++m.j >= n) {
+                ++m.i;
+                m.j = m.i + 1;
+            }
+            if (m.i >= n - 1) {
+                *this = owner->end();
+            }
+            return;
+        case NeighborhoodType::OrOpt:
+        case NeighborhoodType::ThreeOpt: {
+            if (owner->type == NeighborhoodType::OrOpt && !m.reversed && m.j > m.i) {
+                m.reversed = true;
+                return;
+            }
+            m.reversed = false;
+            if (++m.k < n) {
+                return;
+            }
+            m.k = 0;
+            int maxSegment = owner->type == NeighborhoodType::OrOpt ? OR_OPT_MAX_SEGMENT : n - 2;
+            if (++m.j - m.i + 1 > maxSegment || m.j >= n) {
+                ++m.i;
+                m.j = m.i;
+            }
+            if (m.i >= n) {
+                *this = owner->end();
+            }
+            return;
+        }
+    }
+}
+
+template <typename Distances>
+void BasicNeighborhood<Distances>::iterator::step_candidates() {
+    if (++variant < owner->variants()) {
+        return;
+    }
+    variant = 0;
+    if (++candidate < owner->candidates->k()) {
+        return;
+    }
+    candidate = 0;
+    if (++base > owner->lastBase) {
+        *this = owner->end();
+    }
+}
+
+// Ustala ruch dla bieżącego stanu; zwraca false, jeśli stan nie opisuje
+// poprawnego ruchu i trzeba przejść dalej
+template <typename Distances>
+bool BasicNeighborhood<Distances>::iterator::settle() {
+    if (base < 0) {
+        return true;
+    }
+    if (owner->candidates) {
+        return build_candidate_move();
+    }
+    switch (owner->type) {
+        case NeighborhoodType::OrOpt:
+        case NeighborhoodType::ThreeOpt:
+            return position.k < position.i - 1 || position.k > position.j;
+        default:
+            return true;
+    }
+}
+
+// Ruch dodający krawędź między miastem a na pozycji base a jego kandydatem c
+template <typename Distances>
+bool BasicNeighborhood<Distances>::iterator::build_candidate_move() {
+    const vector<int>& cities = owner->route.cities;
+    const vector<int>& pos = owner->positions();
+    int n = cities.size();
+    int i = base;
+    int a = cities[i];
+    int c = owner->candidates->of(a)[candidate];
+    int pc = pos[c];
+    Move& m = position;
+    m = {0, 0, 0.0, owner->type, -1, false};
+
+    switch (owner->type) {
+        case NeighborhoodType::Swap: {
+            // a trafia tuż za c lub tuż przed c
+            int j = variant == 0 ? pc + 1 : pc - 1;
+            if (i < 1 || j < 1 || j >= n || j == i) {
+                return false;
+            }
+            m.i = min(i, j);
+            m.j = max(i, j);
+            return true;
+        }
+        case NeighborhoodType::TwoOpt: {
+            // wariant 0: (a, succ a), (c, succ c) -> (a, c), (succ a, succ c)
+            // wariant 1: (pred a, a), (pred c, c) -> (a, c), (pred a, pred c)
+            int lo = min(i, pc);
+            int hi = max(i, pc);
+            if (hi - lo < 2) {
+                return false;
+            }
+            m.i = variant == 0 ? lo + 1 : lo;
+            m.j = variant == 0 ? hi : hi - 1;
+            return m.i >= 1;
+        }
+        case NeighborhoodType::OrOpt: {
+            int length = variant / 4 + 1;
+            bool anchorAtEnd = (variant / 2) % 2 == 1;
+            bool beforeCandidate = variant % 2 == 1;
+            if (length == 1 && anchorAtEnd) {
+                return false;
+            }
+            m.i = anchorAtEnd ? i - length + 1 : i;
+            m.j = anchorAtEnd ? i : i + length - 1;
+            m.k = beforeCandidate ? (pc + n - 1) % n : pc;
+            // a musi sąsiadować z c po przeniesieniu fragmentu
+            m.reversed = length > 1 && (anchorAtEnd != beforeCandidate);
+            break;
+        }
+        case NeighborhoodType::ThreeOpt: {
+            // Nowe krawędzie (c, a) oraz (b, v), gdzie v = succ(c), a b jest kandydatem v
+            int v = cities[(pc + 1) % n];
+            int b = owner->candidates->of(v)[variant];
+            m.i = i;
+            m.j = pos[b];
+            m.k = pc;
+            break;
+        }
+    }
+    int length = m.j - m.i + 1;
+    return m.i >= 1 && m.j < n && length >= 1 && length <= n - 2 && (m.k < m.i - 1 || m.k > m.j);
+}
+
+template <typename Distances>
+typename BasicNeighborhood<Distances>::iterator& BasicNeighborhood<Distances>::iterator::operator++() {
+    do {
+        step();
+    } while (!settle());
+    return *this;
+}
+
+template <typename Distances>
+typename BasicNeighborhood<Distances>::iterator BasicNeighborhood<Distances>::begin() const {
+    int n = route.cities.size();
+    if (n < 3 || (candidates && candidates->k() == 0)) {
+        return end();
+    }
+    Move first{1, 2, 0.0, type};
+    if (type == NeighborhoodType::OrOpt || type == NeighborhoodType::ThreeOpt) {
+        first = {1, 1, 0.0, type, 0, false};
+    }
+    iterator it(this, first);
+    it.base = candidates ? firstBase : 0;
+    if (!it.settle()) {
+        ++it;
+    }
+    return it;
+}
+
+template <typename Distances>
+typename BasicNeighborhood<Distances>::iterator BasicNeighborhood<Distances>::end() const {
+    iterator it(this, {-1, -1, 0.0, type, -1, false});
+    it.base = -1;
+    return it;
+}
+
+template <typename Distances>
+size_t BasicNeighborhood<Distances>::size() const {
+    size_t n = route.cities.size();
+    if (n < 3) {
+        return 0;
+    }
+    if (candidates) {
+        return distance(begin(), end());
+    }
+    if (type == NeighborhoodType::Swap || type == NeighborhoodType::TwoOpt) {
+        return (n - 1) * (n - 2) / 2;
+    }
+    // Fragment długości L zaczyna się na jednej z n - L pozycji, a można go
+    // wstawić w n - L - 1 miejsc; Or-opt liczy też odwrócone fragmenty (L > 1)
+    size_t maxSegment = type == NeighborhoodType::OrOpt ? OR_OPT_MAX_SEGMENT : n - 2;
+    size_t total = 0;
+    for (size_t length = 1; length <= min(maxSegment, n - 2); ++length) {
+        size_t orientations = (type == NeighborhoodType::OrOpt && length > 1) ? 2 : 1;
+        total += (n - length) * (n - length - 1) * orientations;
+    }
+    return total;
+}
+
 // Funkcja generująca sąsiedztwo
-vector<Route> generate_neighborhood(const Route& currentRoute, const vector<vector<double>>& distanceMatrix) {
-    vector<Route> neighborhood;
-    for (size_t i = 1; i < currentRoute.cities.size() - 1; ++i) {
-        for (size_t j = i + 1; j < currentRoute.cities.size(); ++j) {
-            Route newRoute = currentRoute;
-            swap(newRoute.cities[i], newRoute.cities[j]);
-            newRoute.cost = check_cost(newRoute.cities, distanceMatrix);
-            neighborhood.push_back(newRoute);
+template <typename Distances>
+BasicNeighborhood<Distances> generate_neighborhood(const Route& currentRoute, const Distances& distanceMatrix,
+                                                   NeighborhoodType type, const CandidateList* candidates) {
+    return BasicNeighborhood<Distances>(currentRoute, distanceMatrix, type, candidates);
+}
+
+// Losowy ruch z sąsiedztwa - pozycja 0 pozostaje stała. Dla zamiany i 2-opt
+// rozkład jest jednostajny po parach pozycji; dla ruchów przenoszących
+// losowana jest długość fragmentu, jego początek i miejsce wstawienia.
+template <typename Distances>
+Move random_move(const Route& currentRoute, const Distances& distanceMatrix, mt19937& rgen,
+                 NeighborhoodType type) {
+    int numberOfCities = currentRoute.cities.size();
+    if (type == NeighborhoodType::OrOpt || type == NeighborhoodType::ThreeOpt) {
+        int maxSegment = numberOfCities - 2;
+        if (type == NeighborhoodType::OrOpt) {
+            maxSegment = min(maxSegment, OR_OPT_MAX_SEGMENT);
+        }
+        int length = uniform_int_distribution<int>(1, maxSegment)(rgen);
+        int i = uniform_int_distribution<int>(1, numberOfCities - length)(rgen);
+        int j = i + length - 1;
+        // n - length - 1 dozwolonych miejsc wstawienia, z pominięciem [i - 1, j]
+        int k = uniform_int_distribution<int>(0, numberOfCities - length - 2)(rgen);
+        if (k >= i - 1) {
+            k += length + 1;
         }
+        bool reversed = type == NeighborhoodType::OrOpt && length > 1 && uniform_int_distribution<int>(0, 1)(rgen) == 1;
+        return evaluate_move(currentRoute, {i, j, 0.0, type, k, reversed}, distanceMatrix);
     }
-    return neighborhood;
+
+    uniform_int_distribution<int> first(1, numberOfCities - 1);
+    uniform_int_distribution<int> second(1, numberOfCities - 2);
+    int i = first(rgen);
+    int j = second(rgen);
+    if (j >= i) {
+        ++j;
+    }
+    if (i > j) {
+        swap(i, j);
+    }
+    return evaluate_move(currentRoute, {i, j, 0.0, type}, distanceMatrix);
+}
+
+// Przeniesienie fragmentu [i, j] za pozycję k (k < i - 1 lub k > j)
+static void move_segment(vector<int>& cities, int i, int j, int k, bool reversed) {
+    auto begin = cities.begin();
+    int length = j - i + 1;
+    if (k > j) {
+        rotate(begin + i, begin + j + 1, begin + k + 1);
+        if (reversed) {
+            reverse(begin + k - length + 1, begin + k + 1);
+        }
+    } else {
+        rotate(begin + k + 1, begin + i, begin + j + 1);
+        if (reversed) {
+            reverse(begin + k + 1, begin + k + 1 + length);
+        }
+    }
+}
+
+// Odwrotność move_segment - przywraca fragment na pozycje [i, j]
+static void unmove_segment(vector<int>& cities, int i, int j, int k, bool reversed) {
+    auto begin = cities.begin();
+    int length = j - i + 1;
+    if (k > j) {
+        if (reversed) {
+            reverse(begin + k - length + 1, begin + k + 1);
+        }
+        rotate(begin + i, begin + i + (k - j), begin + k + 1);
+    } else {
+        if (reversed) {
+            reverse(begin + k + 1, begin + k + 1 + length);
+        }
+        rotate(begin + k + 1, begin + k + 1 + length, begin + j + 1);
+    }
+}
+
+// Krawędzie (pary miast) usuwane i dodawane przez ruch, wyznaczane przed jego
+// zastosowaniem - zgodnie z opisami w swap_delta, two_opt_delta i
+// segment_move_delta. Krawędź obecna w trasie przed ruchem i po nim nie jest
+// zwracana. Zwraca liczbę krawędzi w każdej z tablic (najwyżej 4).
+static int move_edges(const vector<int>& cities, const Move& move, pair<int, int> removed[4], pair<int, int> added[4]) {
+    int n = cities.size();
+    auto at = [&](int position) { return cities[(position + n) % n]; };
+    int i = min(move.i, move.j);
+    int j = max(move.i, move.j);
+    int a = cities[i];
+    int b = cities[j];
+    int count = 0;
+    auto exchange = [&](pair<int, int> oldEdge, pair<int, int> newEdge) {
+        removed[count] = oldEdge;
+        added[count] = newEdge;
+        ++count;
+    };
+    switch (move.type) {
+        case NeighborhoodType::Swap:
+            if (i == j || n < 3) {
+                break;
+            }
+            if (j == i + 1) {
+                exchange({at(i - 1), a}, {at(i - 1), b});
+                exchange({b, at(j + 1)}, {a, at(j + 1)});
+            } else if (i == 0 && j == n - 1) {
+                exchange({at(j - 1), b}, {at(j - 1), a});
+                exchange({a, at(i + 1)}, {b, at(i + 1)});
+            } else {
+                exchange({at(i - 1), a}, {at(i - 1), b});
+                exchange({a, at(i + 1)}, {b, at(i + 1)});
+                exchange({at(j - 1), b}, {at(j - 1), a});
+                exchange({b, at(j + 1)}, {a, at(j + 1)});
+            }
+            break;
+        case NeighborhoodType::TwoOpt:
+            if (i == j || (i == 0 && j == n - 1)) {
+                break;
+            }
+            exchange({at(i - 1), a}, {at(i - 1), b});
+            exchange({b, at(j + 1)}, {a, at(j + 1)});
+            break;
+        case NeighborhoodType::OrOpt:
+        case NeighborhoodType::ThreeOpt: {
+            a = cities[move.i];
+            b = cities[move.j];
+            int prev = at(move.i - 1);
+            int next = at(move.j + 1);
+            int u = at(move.k);
+            int v = at(move.k + 1);
+            exchange({prev, a}, {prev, next});
+            if (move.reversed) {
+                exchange({b, next}, {u, b});
+                exchange({u, v}, {a, v});
+            } else {
+                exchange({b, next}, {u, a});
+                exchange({u, v}, {b, v});
+            }
+            break;
+        }
+    }
+    return count;
+}
+
+// Klucz Zobrista nieskierowanej krawędzi - mieszanie (splitmix64) indeksu
+// pary, więc klucze nie wymagają tablicy n x n
+static uint64_t edge_key(int a, int b) {
+    uint64_t x = hash_pair(a, b) + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t tour_hash(const vector<int>& cities) {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < cities.size(); ++i) {
+        hash ^= edge_key(cities[i], cities[(i + 1) % cities.size()]);
+    }
+    return hash;
+}
+
+uint64_t move_hash(const vector<int>& cities, const Move& move) {
+    pair<int, int> removed[4];
+    pair<int, int> added[4];
+    int count = move_edges(cities, move, removed, added);
+    uint64_t change = 0;
+    for (int e = 0; e < count; ++e) {
+        change ^= edge_key(removed[e].first, removed[e].second) ^ edge_key(added[e].first, added[e].second);
+    }
+    return change;
+}
+
+// Zastosowanie ruchu do trasy
+void apply_move(Route& route, const Move& move) {
+    route.hash ^= move_hash(route.cities, move);
+    switch (move.type) {
+        case NeighborhoodType::TwoOpt:
+            reverse(route.cities.begin() + move.i, route.cities.begin() + move.j + 1);
+            break;
+        case NeighborhoodType::Swap:
+            swap(route.cities[move.i], route.cities[move.j]);
+            break;
+        case NeighborhoodType::OrOpt:
+        case NeighborhoodType::ThreeOpt:
+            move_segment(route.cities, move.i, move.j, move.k, move.reversed);
+            break;
+    }
+    route.cost += move.delta;
+}
+
+// Cofnięcie ruchu zastosowanego przez apply_move (zamiana i 2-opt są samoodwrotne)
+void undo_move(Route& route, const Move& move) {
+    switch (move.type) {
+        case NeighborhoodType::TwoOpt:
+            reverse(route.cities.begin() + move.i, route.cities.begin() + move.j + 1);
+            break;
+        case NeighborhoodType::Swap:
+            swap(route.cities[move.i], route.cities[move.j]);
+            break;
+        case NeighborhoodType::OrOpt:
+        case NeighborhoodType::ThreeOpt:
+            unmove_segment(route.cities, move.i, move.j, move.k, move.reversed);
+            break;
+    }
+    route.cost -= move.delta;
+    // Zmiana skrótu liczona na przywróconej trasie - XOR jest samoodwrotny
+    route.hash ^= move_hash(route.cities, move);
+}
+
+// Każdy wątek ma własny generator - domyślnie z ziarnem z random_device
+mt19937& random_engine() {
+    thread_local mt19937 engine(random_device{}());
+    return engine;
+}
+
+void seed_random_engine(unsigned seed, unsigned stream) {
+    seed_seq sequence{seed, stream};
+    random_engine().seed(sequence);
+}
+
+RandomStream::RandomStream(unsigned seed, unsigned stream) : saved(random_engine()) {
+    seed_random_engine(seed, stream);
+}
+
+RandomStream::~RandomStream() {
+    random_engine() = saved;
 }
 
 // Funkcja generująca losowe rozwiązanie
-Route generate_random_solution(int numberOfCities, const vector<vector<double>>& distanceMatrix) {
+template <typename Distances>
+Route generate_random_solution(int numberOfCities, const Distances& distanceMatrix) {
     Route randomRoute;
     randomRoute.cities.resize(numberOfCities);
     for (int i = 0; i < numberOfCities; ++i) {
         randomRoute.cities[i] = i;
     }
-    random_device rd;
-    mt19937 g(rd());
-    shuffle(randomRoute.cities.begin(), randomRoute.cities.end(), g);
+    shuffle(randomRoute.cities.begin(), randomRoute.cities.end(), random_engine());
     randomRoute.cost = check_cost(randomRoute.cities, distanceMatrix);
+    randomRoute.hash = tour_hash(randomRoute.cities);
     return randomRoute;
 }
 
-// Algorytm wspinaczkowy
-Route solve_hill_climbing(const vector<vector<double>>& distanceMatrix, int maxIterations, int& iteration_count) {
+// Najlepszy (lub pierwszy) poprawiający ruch; i == -1, jeśli takiego nie ma
+template <typename Distances>
+static Move select_improving_move(const BasicNeighborhood<Distances>& moves, ImprovementStrategy strategy) {
+    Move bestMove{-1, -1, 0.0};
+    for (const Move& move : moves) {
+        if (move.delta < bestMove.delta) {
+            bestMove = move;
+            if (strategy == ImprovementStrategy::First) {
+                break;
+            }
+        }
+    }
+    return bestMove;
+}
+
+// Miasta, których krawędzie zmienia ruch (wyznaczane przed jego zastosowaniem)
+static int move_endpoints(const vector<int>& cities, const Move& move, int endpoints[6]) {
+    int n = cities.size();
+    int count = 0;
+    auto add = [&](int position) { endpoints[count++] = cities[(position + n) % n]; };
+    add(move.i - 1);
+    add(move.i);
+    add(move.j);
+    add(move.j + 1);
+    switch (move.type) {
+        case NeighborhoodType::Swap:
+            add(move.i + 1);
+            add(move.j - 1);
+            break;
+        case NeighborhoodType::OrOpt:
+        case NeighborhoodType::ThreeOpt:
+            add(move.k);
+            add(move.k + 1);
+            break;
+        case NeighborhoodType::TwoOpt:
+            break;
+    }
+    return count;
+}
+
+// Aktualizacja pozycji miast w zakresie zmienionym przez zastosowany ruch
+static void update_positions(const vector<int>& cities, vector<int>& positions, const Move& move) {
+    int from = move.i;
+    int to = move.j;
+    if (move.type == NeighborhoodType::OrOpt || move.type == NeighborhoodType::ThreeOpt) {
+        from = min(from, move.k + 1);
+        to = max(to, move.k);
+    }
+    for (int p = from; p <= to; ++p) {
+        positions[cities[p]] = p;
+    }
+}
+
+// Algorytm wspinaczkowy od zadanej trasy
+template <typename Distances>
+void improve_hill_climbing(Route& currentRoute, const Distances& distanceMatrix, int maxIterations, int& iteration_count,
+                           ImprovementStrategy strategy, NeighborhoodType neighborhood,
+                           const CandidateList* candidateList, Trace* trace, StopCondition* stop) {
     int numberOfCities = distanceMatrix.size();
-    Route currentRoute = generate_random_solution(numberOfCities, distanceMatrix);
     bool improvement = true;
     iteration_count = 0;
+    auto stopped = [&]() { return stop && stop->reached(currentRoute.cost); };
 
-    ofstream csvFile("hill_climbing.csv");
-    csvFile << "Iteration,Cost\n";  // Nagłówki kolumn
+    if (candidateList && numberOfCities > 2) {
+        // Sąsiedztwo ograniczone do k najbliższych miast, z bitami "nie patrz":
+        // w każdej rundzie sprawdzane są tylko miasta, których krawędzie
+        // zmieniły się od ich ostatniego przeglądu
+        vector<int> positions(numberOfCities);
+        for (int p = 0; p < numberOfCities; ++p) {
+            positions[currentRoute.cities[p]] = p;
+        }
+        DontLookBits dontLook(numberOfCities);
+        for (int city : currentRoute.cities) {
+            dontLook.activate(city);
+        }
 
-    while (improvement && iteration_count < maxIterations) {
-        improvement = false;
-        auto neighborhood = generate_neighborhood(currentRoute, distanceMatrix);
-        for (const auto& neighbor : neighborhood) {
-            if (neighbor.cost < currentRoute.cost) {
-                currentRoute = neighbor;
+        while (!dontLook.empty() && iteration_count < maxIterations && !stopped()) {
+            for (size_t remaining = dontLook.size(); remaining > 0 && !dontLook.empty() && !stopped(); --remaining) {
+                int city = dontLook.pop();
+                Move bestMove = select_improving_move(
+                    BasicNeighborhood<Distances>(currentRoute, distanceMatrix, neighborhood, *candidateList, positions, city),
+                    strategy);
+                if (bestMove.i < 0) {
+                    continue;
+                }
+                int endpoints[6];
+                int count = move_endpoints(currentRoute.cities, bestMove, endpoints);
+                apply_move(currentRoute, bestMove);
+                update_positions(currentRoute.cities, positions, bestMove);
+                for (int e = 0; e < count; ++e) {
+                    dontLook.activate(endpoints[e]);
+                }
+            }
+            iteration_count++;
+            if (trace) {
+                trace->record(iteration_count, currentRoute.cost);
+            }
+        }
+    } else {
+        while (improvement && iteration_count < maxIterations && !stopped()) {
+            improvement = false;
+            Move bestMove = select_improving_move(generate_neighborhood(currentRoute, distanceMatrix, neighborhood), strategy);
+            if (bestMove.i >= 0) {
+                apply_move(currentRoute, bestMove);
                 improvement = true;
             }
+            iteration_count++;
+            if (trace) {
+                trace->record(iteration_count, currentRoute.cost);
+            }
         }
-        iteration_count++;
-        csvFile << iteration_count << "," << currentRoute.cost << "\n";  // Zapis do pliku CSV
     }
-
-    csvFile.close();
-    return currentRoute;
 }
 
-// Algorytm wspinaczkowy z losowym wyborem sąsiada
-Route solve_random_hill_climbing(const vector<vector<double>>& distanceMatrix, int maxIterations, int& iteration_count) {
+// Algorytm wspinaczkowy
+template <typename Distances>
+Route solve_hill_climbing(const Distances& distanceMatrix, int maxIterations, int& iteration_count,
+                          ImprovementStrategy strategy, NeighborhoodType neighborhood, int candidates) {
     int numberOfCities = distanceMatrix.size();
     Route currentRoute = generate_random_solution(numberOfCities, distanceMatrix);
-
-    random_device rd;
-    mt19937 rgen(rd());
-    iteration_count = 0;
-
-    ofstream csvFile("random_hill_climbing.csv");
-    csvFile << "Iteration,Cost\n";  // Nagłówki kolumn
-
-    for (int i = 0; i < maxIterations; ++i) {
-        auto neighborhood = generate_neighborhood(currentRoute, distanceMatrix);
-        uniform_int_distribution<int> dist(0, neighborhood.size() - 1);
-        Route newRoute = neighborhood[dist(rgen)];
-
-        if (newRoute.cost < currentRoute.cost) {
-            currentRoute = newRoute;
-        }
-        iteration_count++;
-        csvFile << iteration_count << "," << currentRoute.cost << "\n";  // Zapis do pliku CSV
+    CandidateList candidateList;
+    if (candidates > 0) {
+        candidateList = CandidateList(distanceMatrix, candidates);
     }
 
-    csvFile.close();
+    Trace trace("hill_climbing");
+
+    improve_hill_climbing(currentRoute, distanceMatrix, maxIterations, iteration_count, strategy, neighborhood,
+                          candidates > 0 ? &candidateList : nullptr, &trace);
     return currentRoute;
 }
 
-// Algorytm pełnego przeglądu z ograniczeniem iteracji
-Route solve_full_review(const vector<vector<double>>& distanceMatrix, int maxIterations, int& iteration_count) {
+// Algorytm wspinaczkowy z losowym wyborem sąsiada od zadanej trasy
+template <typename Distances>
+void improve_random_hill_climbing(Route& currentRoute, const Distances& distanceMatrix, int maxIterations,
+                                  int& iteration_count, Trace* trace, StopCondition* stop) {
     int numberOfCities = distanceMatrix.size();
-    vector<int> cities(numberOfCities);
-    for (int i = 0; i < numberOfCities; ++i) {
-        cities[i] = i;
-    }
-
-    Route bestRoute;
-    bestRoute.cities = cities;
-    bestRoute.cost = check_cost(cities, distanceMatrix);
+    mt19937& rgen = random_engine();
     iteration_count = 0;
 
-    ofstream csvFile("full_review.csv");
-    csvFile << "Iteration,Cost\n";  // Nagłówki kolumn
-
-    do {
-        Route currentRoute;
-        currentRoute.cities = cities;
-        currentRoute.cost = check_cost(cities, distanceMatrix);
+    for (int i = 0; i < maxIterations && numberOfCities > 2; ++i) {
+        if (stop && stop->reached(currentRoute.cost)) {
+            break;
+        }
+        Move move = random_move(currentRoute, distanceMatrix, rgen);
 
-        if (currentRoute.cost < bestRoute.cost) {
-            bestRoute = currentRoute;
+        if (move.delta < 0.0) {
+            apply_move(currentRoute, move);
         }
         iteration_count++;
-        csvFile << iteration_count << "," << currentRoute.cost << "\n";  // Zapis do pliku CSV
-
-        if (iteration_count >= maxIterations) {
-            break;
+        if (trace) {
+            trace->record(iteration_count, currentRoute.cost);
         }
-    } while (next_permutation(cities.begin(), cities.end()));
-
-    csvFile.close();
-    return bestRoute;
+    }
 }
 
-// Algorytm Tabu Search
-Route solve_tabu(const vector<vector<double>>& distanceMatrix, int tabuSize, int maxIterations, int& iteration_count) {
+// Algorytm wspinaczkowy z losowym wyborem sąsiada
+template <typename Distances>
+Route solve_random_hill_climbing(const Distances& distanceMatrix, int maxIterations, int& iteration_count) {
     int numberOfCities = distanceMatrix.size();
     Route currentRoute = generate_random_solution(numberOfCities, distanceMatrix);
-    list<Route> tabuList;
-    set<vector<int>> tabuSet;
 
-    tabuList.push_back(currentRoute);
-    tabuSet.insert(currentRoute.cities);
+    Trace trace("random_hill_climbing");
+
+    improve_random_hill_climbing(currentRoute, distanceMatrix, maxIterations, iteration_count, &trace);
+    return currentRoute;
+}
+
+// Algorytm Tabu Search z pamięcią atrybutów ruchów: krawędź usunięta z trasy
+// nie może do niej wrócić przez tabuSize iteracji. Pamięć to trójkątna macierz
+// iteracji wygaśnięcia indeksowana przez hash_pair, więc sprawdzenie ruchu jest
+// O(1), a rozmiar pamięci nie zależy od kadencji. Pamięć długoterminowa to
+// zbiór skrótów Zobrista odwiedzonych tras - ruch prowadzący do trasy już
+// odwiedzonej wybierany jest tylko w ostateczności. Skrót trasy po ruchu
+// liczony jest w O(1) z usuwanych i dodawanych krawędzi. Ruch tabu jest
+// dopuszczany, jeśli daje trasę lepszą od najlepszej znalezionej (kryterium aspiracji).
+template <typename Distances>
+Route solve_tabu(const Distances& distanceMatrix, int tabuSize, int maxIterations, int& iteration_count,
+                 NeighborhoodType neighborhood, int candidates) {
+    int numberOfCities = distanceMatrix.size();
+    Route currentRoute = generate_random_solution(numberOfCities, distanceMatrix);
+    CandidateList candidateList;
+    if (candidates > 0) {
+        candidateList = CandidateList(distanceMatrix, candidates);
+    }
+    const CandidateList* candidatesPtr = candidates > 0 ? &candidateList : nullptr;
+    vector<int> tabuExpiry(hash_pair(numberOfCities, 0), 0);
+    TourHashSet visited(min(maxIterations, 1 << 20) + 1);
+    visited.insert(currentRoute.hash);
+    // Wygaśnięcie przypisane ruchom prowadzącym do odwiedzonych tras
+    const int revisit = numeric_limits<int>::max() - 1;
 
     Route bestRoute = currentRoute;
     iteration_count = 0;
 
-    ofstream csvFile("tabu_search.csv");
-    csvFile << "Iteration,Cost\n";  // Nagłówki kolumn
+    Trace trace("tabu_search");
 
-    for (int i = 0; i < maxIterations; ++i) {
-        auto neighborhood = generate_neighborhood(currentRoute, distanceMatrix);
-
-        neighborhood.erase(remove_if(neighborhood.begin(), neighborhood.end(), [&](Route& neighbor) {
-            return tabuSet.count(neighbor.cities) > 0;
-        }), neighborhood.end());
+    pair<int, int> removed[4];
+    pair<int, int> added[4];
+    for (int i = 0; i < maxIterations && numberOfCities > 2; ++i) {
+        // Najlepszy ruch spoza listy tabu. Przynależność do tabu sprawdzamy tylko
+        // dla ruchów, które poprawiają dotychczasowego kandydata. Gdy wszystkie
+        // ruchy są tabu, wybierany jest ten, którego tabu wygasa najwcześniej.
+        Move bestMove{-1, -1, numeric_limits<double>::infinity()};
+        Move oldestTabuMove{-1, -1, numeric_limits<double>::infinity()};
+        int oldestExpiry = numeric_limits<int>::max();
+        for (const Move& move : generate_neighborhood(currentRoute, distanceMatrix, neighborhood, candidatesPtr)) {
+            if (move.delta >= bestMove.delta) {
+                continue;
+            }
+            int expiry = 0;
+            if (currentRoute.cost + move.delta >= bestRoute.cost) {
+                int count = move_edges(currentRoute.cities, move, removed, added);
+                uint64_t nextHash = currentRoute.hash;
+                for (int e = 0; e < count; ++e) {
+                    expiry = max(expiry, tabuExpiry[hash_pair(added[e].first, added[e].second)]);
+                    nextHash ^= edge_key(removed[e].first, removed[e].second) ^ edge_key(added[e].first, added[e].second);
+                }
+                if (visited.contains(nextHash)) {
+                    expiry = revisit;
+                }
+            }
+            if (expiry <= iteration_count) {
+                bestMove = move;
+            } else if (bestMove.i < 0 && (expiry < oldestExpiry || (expiry == oldestExpiry && move.delta < oldestTabuMove.delta))) {
+                oldestTabuMove = move;
+                oldestExpiry = expiry;
+            }
+        }
+        if (bestMove.i < 0) {
+            bestMove = oldestTabuMove;
+        }
 
-        if (neighborhood.empty()) {
+        if (bestMove.i < 0) {
             // Brak dostępnych sąsiadów, koniec algorytmu
             break;
         }
 
-        auto nextRoute = *min_element(neighborhood.begin(), neighborhood.end(), [](const Route& lhs, const Route& rhs) {
-            return lhs.cost < rhs.cost;
-        });
-
-        if (nextRoute.cost < bestRoute.cost) {
-            bestRoute = nextRoute;
+        int count = move_edges(currentRoute.cities, bestMove, removed, added);
+        for (int e = 0; e < count; ++e) {
+            tabuExpiry[hash_pair(removed[e].first, removed[e].second)] = iteration_count + 1 + tabuSize;
         }
+        apply_move(currentRoute, bestMove);
+        visited.insert(currentRoute.hash);
 
-        tabuList.push_back(nextRoute);
-        tabuSet.insert(nextRoute.cities);
-
-        if (tabuList.size() > tabuSize) {
-            tabuSet.erase(tabuList.front().cities);
-            tabuList.pop_front();
+        if (currentRoute.cost < bestRoute.cost) {
+            bestRoute = currentRoute;
         }
 
-        currentRoute = nextRoute;
         iteration_count++;
-        csvFile << iteration_count << "," << currentRoute.cost << "\n";  // Zapis do pliku CSV
+        trace.record(iteration_count, currentRoute.cost);
     }
-
-    csvFile.close();
     return bestRoute;
 }
 
 // Algorytm wyżarzania
-Route solve_simulated_annealing(const vector<vector<double>>& distanceMatrix, function<double(int)> T, int maxIterations, int& iteration_count) {
+template <typename Distances>
+Route solve_simulated_annealing(const Distances& distanceMatrix, function<double(int)> T, int maxIterations, int& iteration_count,
+                                NeighborhoodType neighborhood) {
     int numberOfCities = distanceMatrix.size();
     Route bestRoute = generate_random_solution(numberOfCities, distanceMatrix);
     Route currentRoute = bestRoute;
 
-    random_device rd;
-    mt19937 rgen(rd());
+    mt19937& rgen = random_engine();
     iteration_count = 0;
 
-    ofstream csvFile("simulated_annealing.csv");
-    csvFile << "Iteration,Cost\n";  // Nagłówki kolumn
+    Trace trace("simulated_annealing");
 
-    for (int i = 0; i < maxIterations; ++i) {
-        auto neighborhood = generate_neighborhood(currentRoute, distanceMatrix);
-        uniform_int_distribution<int> dist(0, neighborhood.size() - 1);
-        Route newRoute = neighborhood[dist(rgen)];
+    for (int i = 0; i < maxIterations && numberOfCities > 2; ++i) {
+        Move move = random_move(currentRoute, distanceMatrix, rgen, neighborhood);
 
-        if (newRoute.cost < currentRoute.cost) {
-            currentRoute = newRoute;
-            if (newRoute.cost < bestRoute.cost) {
-                bestRoute = newRoute;
+        if (move.delta < 0.0) {
+            apply_move(currentRoute, move);
+            if (currentRoute.cost < bestRoute.cost) {
+                bestRoute = currentRoute;
             }
         } else {
             uniform_real_distribution<double> u(0.0, 1.0);
-            if (u(rgen) < exp(-abs(newRoute.cost - currentRoute.cost) / T(i))) {
-                currentRoute = newRoute;
+            if (u(rgen) < exp(-abs(move.delta) / T(i))) {
+                apply_move(currentRoute, move);
             }
         }
         iteration_count++;
-        csvFile << iteration_count << "," << currentRoute.cost << "\n";  // Zapis do pliku CSV
+        trace.record(iteration_count, currentRoute.cost);
     }
-
-    csvFile.close();
     return bestRoute;
 }
 
 // Funkcja wczytująca dane z pliku CSV
-pair<vector<string>, vector<vector<double>>> read_csv(const string& filename) {
-    vector<vector<double>> matrix;
+pair<vector<string>, DistanceMatrix> read_csv(const string& filename) {
     vector<string> cityNames;
     ifstream file(filename);
     if (!file) {
@@ -255,25 +919,172 @@ pair<vector<string>, vector<vector<double>>> read_csv(const string& filename) {
         }
     }
 
-    // Wczytaj macierz odległości
-    while (getline(file, line)) {
+    // Wczytaj macierz odległości bezpośrednio do bufora macierzy
+    DistanceMatrix matrix(cityNames.size());
+    size_t rowCount = 0;
+    while (getline(file, line) && rowCount < matrix.size()) {
         istringstream iss(line);
         string cityName;
         getline(iss, cityName, ';'); // Pomijamy nazwę miasta w wierszu
-        vector<double> row;
+        double* row = matrix.row(rowCount);
+        size_t column = 0;
         string value;
-        while (getline(iss, value, ';')) {
+        while (getline(iss, value, ';') && column < matrix.size()) {
             if (!value.empty()) {
-                row.push_back(stod(value));
+                row[column++] = stod(value);
             }
         }
-        matrix.push_back(row);
+        if (column != matrix.size()) {
+            cerr << "Plik " << filename << ": wiersz " << rowCount + 1 << " ma " << column
+                 << " wartości zamiast " << matrix.size() << "." << endl;
+            exit(1);
+        }
+        ++rowCount;
+    }
+
+    if (matrix.empty() || rowCount != matrix.size()) {
+        cerr << "Plik " << filename << " jest pusty lub niepoprawny." << endl;
+        exit(1);
+    }
+
+    matrix.update_symmetry();
+    return {cityNames, move(matrix)};
+}
+
+GeoCities read_latlon_csv(const string& filename) {
+    ifstream file(filename);
+    if (!file) {
+        cerr << "Nie można otworzyć pliku: " << filename << endl;
+        exit(1);
+    }
+
+    GeoCities cities;
+    string line;
+    getline(file, line); // Pomijamy nagłówek
+    size_t lineNumber = 1;
+    while (getline(file, line)) {
+        ++lineNumber;
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue; // Pusty wiersz
+        }
+        istringstream iss(line);
+        string name, latitude, longitude;
+        getline(iss, name, ';');
+        getline(iss, latitude, ';');
+        getline(iss, longitude, ';');
+        char* latitudeEnd = nullptr;
+        char* longitudeEnd = nullptr;
+        double phi = strtod(latitude.c_str(), &latitudeEnd);
+        double lambda = strtod(longitude.c_str(), &longitudeEnd);
+        if (name.empty() || latitudeEnd == latitude.c_str() || longitudeEnd == longitude.c_str()
+            || abs(phi) > 90.0 || abs(lambda) > 180.0) {
+            cerr << "Plik " << filename << ": niepoprawny wiersz " << lineNumber
+                 << " (oczekiwano nazwa;szerokość;długość w stopniach)." << endl;
+            exit(1);
+        }
+        cities.names.push_back(name);
+        cities.latitude.push_back(phi);
+        cities.longitude.push_back(lambda);
+    }
+
+    if (cities.names.empty()) {
+        cerr << "Plik " << filename << " jest pusty lub niepoprawny." << endl;
+        exit(1);
+    }
+    return cities;
+}
+
+pair<vector<string>, DistanceMatrix> read_text_matrix(const string& filename) {
+    ifstream file(filename);
+    if (!file) {
+        cerr << "Nie można otworzyć pliku: " << filename << endl;
+        exit(1);
+    }
+
+    vector<string> cityNames;
+    string line;
+    if (getline(file, line)) {
+        istringstream iss(line);
+        string cityName;
+        while (iss >> cityName) {
+            cityNames.push_back(cityName);
+        }
     }
 
-    if (matrix.empty()) {
+    DistanceMatrix matrix(cityNames.size());
+    size_t rowCount = 0;
+    while (rowCount < matrix.size() && getline(file, line)) {
+        istringstream iss(line);
+        string cityName;
+        if (!(iss >> cityName)) {
+            continue; // Pusty wiersz
+        }
+        double* row = matrix.row(rowCount);
+        size_t column = 0;
+        while (column < matrix.size() && iss >> row[column]) {
+            ++column;
+        }
+        if (column != matrix.size()) {
+            cerr << "Plik " << filename << ": wiersz " << rowCount + 1 << " ma " << column
+                 << " wartości zamiast " << matrix.size() << "." << endl;
+            exit(1);
+        }
+        ++rowCount;
+    }
+
+    if (matrix.empty() || rowCount != matrix.size()) {
         cerr << "Plik " << filename << " jest pusty lub niepoprawny." << endl;
         exit(1);
     }
 
-    return {cityNames, matrix};
+    matrix.update_symmetry();
+    return {cityNames, move(matrix)};
+}
+
+pair<vector<string>, DistanceMatrix> read_instance(const string& filename, bool verify) {
+    if (is_binary_matrix_file(filename)) {
+        return map_binary_matrix(filename, verify);
+    }
+    if (is_tsplib_file(filename)) {
+        TsplibInstance instance = read_tsplib(filename);
+        return {instance.city_names(), move(instance).distance_matrix()};
+    }
+    if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".csv") == 0) {
+        return read_csv(filename);
+    }
+    return read_text_matrix(filename);
+}
+
+// Indeks nieuporządkowanej pary miast w macierzy trójkątnej (z przekątną):
+// hash_pair(a, b) == hash_pair(b, a), a pary miast < n dają kolejne wartości
+// 0 .. hash_pair(n, 0) - 1 bez kolizji
+size_t hash_pair(int a, int b) {
+    size_t low = min(a, b);
+    size_t high = max(a, b);
+    return high * (high + 1) / 2 + low;
 }
+
+// Jawne instancje szablonów dla wszystkich dostawców odległości
+#define TSP_INSTANTIATE(Distances)                                                                              \
+    template double check_cost(const vector<int>&, const Distances&);                                         \
+    template double swap_delta(const vector<int>&, int, int, const Distances&);                               \
+    template double two_opt_delta(const vector<int>&, int, int, const Distances&);                            \
+    template double segment_move_delta(const vector<int>&, int, int, int, bool, const Distances&);            \
+    template Move evaluate_move(const Route&, Move, const Distances&);                                        \
+    template class BasicNeighborhood<Distances>;                                                              \
+    template BasicNeighborhood<Distances> generate_neighborhood(const Route&, const Distances&,               \
+                                                                NeighborhoodType, const CandidateList*);      \
+    template Move random_move(const Route&, const Distances&, mt19937&, NeighborhoodType);                    \
+    template Route generate_random_solution(int, const Distances&);                                           \
+    template void improve_hill_climbing(Route&, const Distances&, int, int&, ImprovementStrategy,             \
+                                        NeighborhoodType, const CandidateList*, Trace*, StopCondition*);      \
+    template Route solve_hill_climbing(const Distances&, int, int&, ImprovementStrategy, NeighborhoodType, int); \
+    template void improve_random_hill_climbing(Route&, const Distances&, int, int&, Trace*,                    \
+                                               StopCondition*);                                               \
+    template Route solve_random_hill_climbing(const Distances&, int, int&);                                   \
+    template Route solve_tabu(const Distances&, int, int, int&, NeighborhoodType, int);                       \
+    template Route solve_simulated_annealing(const Distances&, function<double(int)>, int, int&, NeighborhoodType);
+
+TSP_INSTANTIATE(DistanceMatrix)
+TSP_INSTANTIATE(EuclideanDistances)
+TSP_INSTANTIATE(HaversineDistances)
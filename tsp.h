@@ -1,35 +1,339 @@
 #ifndef TSP_H
 #define TSP_H
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <functional>
+#include <iterator>
+#include <random>
+#include "distance_matrix.h"
+#include "candidate_list.h"
+#include "coordinate_distances.h"
 
 using namespace std;
 
+class Trace;
+
+// Skrót Zobrista całej trasy - O(n)
+uint64_t tour_hash(const vector<int>& cities);
+
+// hash - skrót Zobrista trasy (XOR kluczy jej nieskierowanych krawędzi), niezależny
+// od punktu startu i kierunku obiegu. Konstruktor z listą miast liczy go przez
+// tour_hash, a apply_move / undo_move aktualizują go w O(1). Kod zmieniający
+// cities bezpośrednio musi sam ustawić hash = tour_hash(cities).
 struct Route {
+    Route() = default;
+    Route(vector<int> cities, double cost) : cities(move(cities)), cost(cost), hash(tour_hash(this->cities)) {}
+
     vector<int> cities;
-    double cost;
+    double cost = 0.0;
+    uint64_t hash = 0;
+};
+
+// Funkcje i algorytmy z tsp.cpp są szablonowe względem dostawcy odległości
+// (Distances): DistanceMatrix lub dostawcy liczący odległości ze współrzędnych
+// (coordinate_distances.h). Instancje dla tych trzech typów tworzone są jawnie
+// w tsp.cpp, więc dla macierzy kod jest taki sam jak bez szablonów.
+
+template <typename Distances>
+double check_cost(const vector<int>& route, const Distances& distanceMatrix);
+
+template <typename Distances>
+double swap_delta(const vector<int>& route, int i, int j, const Distances& distanceMatrix);
+
+template <typename Distances>
+double two_opt_delta(const vector<int>& route, int i, int j, const Distances& distanceMatrix);
+
+template <typename Distances>
+double segment_move_delta(const vector<int>& route, int i, int j, int k, bool reversed, const Distances& distanceMatrix);
+
+// Rodzaj sąsiedztwa (typ ruchu)
+enum class NeighborhoodType {
+    Swap,     // zamiana miast na pozycjach i oraz j
+    TwoOpt,   // wymiana dwóch krawędzi - odwrócenie fragmentu trasy [i, j]
+    OrOpt,    // przeniesienie fragmentu [i, j] o długości 1-3 za pozycję k, opcjonalnie odwróconego
+    ThreeOpt  // ograniczone 3-opt: przeniesienie fragmentu [i, j] dowolnej długości za pozycję k
+              // bez odwracania (wymiana trzech krawędzi z zachowaniem kierunku)
+};
+
+// Maksymalna długość fragmentu przenoszonego ruchem Or-opt
+constexpr int OR_OPT_MAX_SEGMENT = 3;
+
+// Ruch w sąsiedztwie: pozycje i <= j wraz ze zmianą kosztu. Dla ruchów
+// przenoszących fragment k to pozycja, za którą wstawiany jest fragment [i, j].
+struct Move {
+    int i;
+    int j;
+    double delta;
+    NeighborhoodType type = NeighborhoodType::Swap;
+    int k = -1;
+    bool reversed = false;
+};
+
+// Leniwe sąsiedztwo trasy - kolejne ruchy i ich koszt wyznaczane są dopiero
+// przy odczycie iteratora, bez kopiowania trasy. Trasa nie może się zmieniać
+// w trakcie przeglądania. Z listami kandydatów sąsiedztwo zawiera tylko ruchy
+// dodające krawędź między miastem a jednym z jego k najbliższych (O(n·k)
+// ruchów zamiast O(n²)); ten sam ruch może wtedy pojawić się więcej niż raz.
+template <typename Distances>
+class BasicNeighborhood {
+public:
+    class iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = Move;
+        using difference_type = ptrdiff_t;
+        using pointer = const Move*;
+        using reference = Move;
+
+        iterator(const BasicNeighborhood* owner, const Move& position) : owner(owner), position(position) {}
+
+        Move operator*() const;
+        iterator& operator++();
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+        bool operator==(const iterator& other) const {
+            return position.i == other.position.i && position.j == other.position.j
+                && position.k == other.position.k && position.reversed == other.position.reversed
+                && base == other.base && candidate == other.candidate && variant == other.variant;
+        }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class BasicNeighborhood;
+
+        void step();
+        void step_candidates();
+        bool settle();
+        bool build_candidate_move();
+
+        const BasicNeighborhood* owner;
+        Move position;
+        // Stan przeglądu list kandydatów: pozycja miasta bazowego, indeks
+        // kandydata i wariant ruchu dodającego krawędź do kandydata
+        int base = 0;
+        int candidate = 0;
+        int variant = 0;
+    };
+
+    BasicNeighborhood(const Route& route, const Distances& distanceMatrix, NeighborhoodType type = NeighborhoodType::Swap,
+                      const CandidateList* candidates = nullptr);
+
+    // Tylko ruchy dodające krawędź z miasta baseCity do jego kandydatów;
+    // positions to aktualne pozycje miast w trasie, utrzymywane przez wołającego
+    BasicNeighborhood(const Route& route, const Distances& distanceMatrix, NeighborhoodType type,
+                      const CandidateList& candidates, const vector<int>& positions, int baseCity);
+
+    iterator begin() const;
+    iterator end() const;
+    size_t size() const;
+
+private:
+    int variants() const;
+    const vector<int>& positions() const { return externalPositions ? *externalPositions : ownPositions; }
+
+    const Route& route;
+    const Distances& distanceMatrix;
+    NeighborhoodType type;
+    const CandidateList* candidates;
+    // Pozycje miast w trasie (tylko z listami kandydatów)
+    vector<int> ownPositions;
+    const vector<int>* externalPositions = nullptr;
+    // Zakres pozycji miast bazowych przeglądanych z listami kandydatów
+    int firstBase = 0;
+    int lastBase = -1;
+};
+
+using Neighborhood = BasicNeighborhood<DistanceMatrix>;
+
+// Strategia wyboru ruchu w przeszukiwaniu lokalnym
+enum class ImprovementStrategy { Best, First };
+
+template <typename Distances>
+BasicNeighborhood<Distances> generate_neighborhood(const Route& currentRoute, const Distances& distanceMatrix,
+                                                   NeighborhoodType type = NeighborhoodType::Swap,
+                                                   const CandidateList* candidates = nullptr);
+
+template <typename Distances>
+Move random_move(const Route& currentRoute, const Distances& distanceMatrix, mt19937& rgen,
+                 NeighborhoodType type = NeighborhoodType::Swap);
+
+template <typename Distances>
+Move evaluate_move(const Route& route, Move move, const Distances& distanceMatrix);
+
+void apply_move(Route& route, const Move& move);
+
+void undo_move(Route& route, const Move& move);
+
+// Zmiana skrótu trasy po ruchu (liczona przed jego zastosowaniem) - O(1):
+// skrót trasy po ruchu to route.hash ^ move_hash(route.cities, move)
+uint64_t move_hash(const vector<int>& cities, const Move& move);
+
+// Generator liczb losowych bieżącego wątku. Bez seed_random_engine() ziarno
+// pochodzi z random_device; z nim przebieg wątku jest powtarzalny. Różne
+// wartości stream dają niezależne ciągi dla tego samego seed.
+mt19937& random_engine();
+
+void seed_random_engine(unsigned seed, unsigned stream = 0);
+
+// Na czas życia obiektu generator wątku daje ciąg (seed, stream); destruktor
+// przywraca poprzedni stan - solver uruchomiony w wątku wywołującym nie
+// narzuca ziarna późniejszym użytkownikom random_engine()
+class RandomStream {
+public:
+    RandomStream(unsigned seed, unsigned stream);
+    ~RandomStream();
+    RandomStream(const RandomStream&) = delete;
+    RandomStream& operator=(const RandomStream&) = delete;
+
+private:
+    mt19937 saved;
+};
+
+template <typename Distances>
+Route generate_random_solution(int numberOfCities, const Distances& distanceMatrix);
+
+template <typename Distances>
+Route solve_hill_climbing(const Distances& distanceMatrix, int maxIterations, int& iteration_count,
+                          ImprovementStrategy strategy = ImprovementStrategy::Best,
+                          NeighborhoodType neighborhood = NeighborhoodType::Swap, int candidates = 0);
+
+template <typename Distances>
+Route solve_random_hill_climbing(const Distances& distanceMatrix, int maxIterations, int& iteration_count);
+
+// Warunek wczesnego zatrzymania przeszukiwań lokalnych działających równolegle:
+// trasa o koszcie co najwyżej target ustawia flagę, a ustawiona flaga przerywa
+// wszystkie przeszukiwania sprawdzające ten sam warunek
+struct StopCondition {
+    explicit StopCondition(double target) : target(target) {}
+
+    bool reached(double cost) {
+        if (cost <= target) {
+            flag.store(true, memory_order_relaxed);
+        }
+        return flag.load(memory_order_relaxed);
+    }
+
+    double target;
+    atomic<bool> flag{false};
 };
 
-double check_cost(const vector<int>& route, const vector<vector<double>>& distanceMatrix);
+// Przeszukiwanie lokalne od zadanej trasy (bez losowania startu). trace == nullptr
+// wyłącza zapis przebiegu; candidates == nullptr to pełne sąsiedztwo; stop
+// sprawdzany jest po każdej iteracji (i każdym ruchu przy listach kandydatów).
+template <typename Distances>
+void improve_hill_climbing(Route& route, const Distances& distanceMatrix, int maxIterations, int& iteration_count,
+                           ImprovementStrategy strategy, NeighborhoodType neighborhood,
+                           const CandidateList* candidates = nullptr, Trace* trace = nullptr,
+                           StopCondition* stop = nullptr);
+
+template <typename Distances>
+void improve_random_hill_climbing(Route& route, const Distances& distanceMatrix, int maxIterations,
+                                  int& iteration_count, Trace* trace = nullptr, StopCondition* stop = nullptr);
+
+// Wielostartowe przeszukiwanie lokalne: starts niezależnych startów rozdzielonych
+// między wątki, ze wspólną najlepszą trasą. Start s używa generatora o ziarnie
+// wyznaczonym z (seed, s), więc jego wynik nie zależy od przydziału do wątków.
+// Po osiągnięciu kosztu targetCost przez dowolny start wszystkie trwające starty
+// są przerywane, a nowe nie są rozpoczynane.
+Route solve_multi_start(const DistanceMatrix& distanceMatrix, int starts, int maxIterations, int& iteration_count,
+                        bool randomNeighbor = false, ImprovementStrategy strategy = ImprovementStrategy::Best,
+                        NeighborhoodType neighborhood = NeighborhoodType::Swap, int candidates = 0,
+                        double targetCost = 0.0, unsigned seed = 0, int threads = 0);
 
-vector<Route> generate_neighborhood(const Route& currentRoute, const vector<vector<double>>& distanceMatrix);
+// Największa liczba miast dla pełnego przeglądu (miasta są bitami maski 32-bitowej)
+constexpr int FULL_REVIEW_MAX_CITIES = 32;
 
-Route generate_random_solution(int numberOfCities, const vector<vector<double>>& distanceMatrix);
+Route solve_full_review(const DistanceMatrix& distanceMatrix, int maxIterations, int& iteration_count, int threads = 0);
 
-Route solve_hill_climbing(const vector<vector<double>>& distanceMatrix, int maxIterations, int& iteration_count);
+// Największa liczba miast obsługiwana przez dokładny algorytm Helda-Karpa
+constexpr int HELD_KARP_MAX_CITIES = 25;
 
-Route solve_random_hill_climbing(const vector<vector<double>>& distanceMatrix, int maxIterations, int& iteration_count);
+Route solve_held_karp(const DistanceMatrix& distanceMatrix, int& iteration_count, int threads = 0);
 
-Route solve_full_review(const vector<vector<double>>& distanceMatrix, int maxIterations, int& iteration_count);
+// Metoda podziału i ograniczeń z ograniczeniem dolnym z 1-drzew (Held-Karp) -
+// przeznaczona dla instancji do około stu miast
+constexpr int BRANCH_AND_BOUND_MAX_CITIES = 100;
+
+// Zwraca najlepszą znalezioną trasę; gap to względna luka między nią a ograniczeniem
+// dolnym (0 - optimum udowodnione, > 0 - przerwano po timeLimitSeconds)
+Route solve_branch_and_bound(const DistanceMatrix& distanceMatrix, double timeLimitSeconds, int& iteration_count, double& gap);
+
+template <typename Distances>
+Route solve_tabu(const Distances& distanceMatrix, int tabuSize, int maxIterations, int& iteration_count,
+                 NeighborhoodType neighborhood = NeighborhoodType::Swap, int candidates = 0);
+
+Route solve_lin_kernighan(const DistanceMatrix& distanceMatrix, int maxIterations, int& iteration_count,
+                          int maxDepth = 12, int maxBreadth = 10, int candidates = 10);
+
+template <typename Distances>
+Route solve_simulated_annealing(const Distances& distanceMatrix, function<double(int)> T, int maxIterations, int& iteration_count,
+                                NeighborhoodType neighborhood = NeighborhoodType::Swap);
+
+enum class CrossoverType {
+    Order,              // krzyżowanie porządkowe (OX)
+    EdgeRecombination   // rekombinacja krawędzi (ERX)
+};
+
+// Algorytm genetyczny w modelu wyspowym - jedna wyspa (populacja) na wątek,
+// z migracją najlepszych osobników co migrationInterval pokoleń.
+// islands == 0 - tyle wysp, ile wątków sprzętowych.
+Route solve_genetic(const DistanceMatrix& distanceMatrix, int populationSize, int generations, int& iteration_count,
+                    CrossoverType crossover = CrossoverType::Order, double mutationRate = 0.1, int islands = 0,
+                    int migrationInterval = 50, int migrants = 2, unsigned seed = 0);
+
+// Algorytm mrówkowy MAX-MIN Ant System: ants mrówek na iterację (0 - tyle, ile
+// miast), wybór następnego miasta spośród candidates najbliższych,
+// evaporation - współczynnik parowania feromonu.
+Route solve_ant_colony(const DistanceMatrix& distanceMatrix, int ants, int maxIterations, int& iteration_count,
+                       double beta = 3.0, double evaporation = 0.02, int candidates = 15, unsigned seed = 0,
+                       int threads = 0);
+
+// Statystyki jednej temperatury w wyżarzaniu z wymianą replik. Wymiany dotyczą
+// pary (k, k + 1) i są liczone przy niższej temperaturze k.
+struct ReplicaStats {
+    double temperature = 0.0;
+    long long proposed = 0;
+    long long accepted = 0;
+    long long swapAttempts = 0;
+    long long swapsAccepted = 0;
+};
+
+// Geometryczna drabina temperatur od minTemperature do maxTemperature
+// (wymaga 0 < minTemperature <= maxTemperature)
+vector<double> temperature_ladder(double minTemperature, double maxTemperature, int replicas);
+
+// Wyżarzanie z wymianą replik - jedna replika (wątek) na temperaturę.
+// maxIterations to liczba iteracji każdej repliki.
+Route solve_parallel_tempering(const DistanceMatrix& distanceMatrix, const vector<double>& temperatures, int maxIterations,
+                               int& iteration_count, vector<ReplicaStats>& stats, int swapInterval = 100,
+                               NeighborhoodType neighborhood = NeighborhoodType::Swap, unsigned seed = 0);
+
+pair<vector<string>, DistanceMatrix> read_csv(const string& filename);
+
+// Miasta ze współrzędnymi geograficznymi w stopniach dziesiętnych
+struct GeoCities {
+    vector<string> names;
+    vector<double> latitude;
+    vector<double> longitude;
+};
 
-Route solve_tabu(const vector<vector<double>>& distanceMatrix, int tabuSize, int maxIterations, int& iteration_count);
+// Plik CSV ze współrzędnymi miast (separator ';'): wiersz nagłówka, a dalej
+// wiersze nazwa;szerokość;długość. Odległości liczy HaversineDistances.
+GeoCities read_latlon_csv(const string& filename);
 
-Route solve_simulated_annealing(const vector<vector<double>>& distanceMatrix, function<double(int)> T, int maxIterations, int& iteration_count);
+// Macierz w pliku tekstowym rozdzielanym białymi znakami (jak dane.txt): pierwszy
+// wiersz to nazwy miast, kolejne - nazwa miasta i wiersz macierzy
+pair<vector<string>, DistanceMatrix> read_text_matrix(const string& filename);
 
-pair<vector<string>, vector<vector<double>>> read_csv(const string& filename);
+// Wczytuje instancję w formacie wykrytym z zawartości pliku: binarnym
+// (binary_matrix.h - mapowany bez kopiowania), TSPLIB, CSV (rozszerzenie .csv)
+// albo macierz tekstowa. verify == true sprawdza sumę kontrolną pliku binarnego
+// (jeden odczyt całej macierzy); false zostawia wczytanie natychmiastowym.
+pair<vector<string>, DistanceMatrix> read_instance(const string& filename, bool verify = true);
 
+// Indeks nieuporządkowanej pary miast w macierzy trójkątnej
 size_t hash_pair(int a, int b);
 
 #endif // TSP_H
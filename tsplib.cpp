@@ -0,0 +1,269 @@
+#include "tsplib.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+namespace {
+
+// Zaokrąglenie do najbliższej liczby całkowitej w sensie TSPLIB (nint)
+double nint(double value) { return static_cast<int>(value + 0.5); }
+
+// Współrzędna GEO (stopnie.minuty) w radianach
+double geo_radians(double value) {
+    const double PI = 3.141592;  // wartość z definicji TSPLIB
+    int degrees = static_cast<int>(value);
+    double minutes = value - degrees;
+    return PI * (degrees + 5.0 * minutes / 3.0) / 180.0;
+}
+
+string trim(const string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == string::npos) {
+        return "";
+    }
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+// Podział wiersza nagłówka na klucz i wartość ("KLUCZ : wartość" albo samo "KLUCZ")
+pair<string, string> split_keyword(const string& line) {
+    size_t colon = line.find(':');
+    if (colon == string::npos) {
+        return {trim(line), ""};
+    }
+    return {trim(line.substr(0, colon)), trim(line.substr(colon + 1))};
+}
+
+[[noreturn]] void fail(const string& filename, const string& message) {
+    cerr << "Plik TSPLIB " << filename << ": " << message << endl;
+    exit(1);
+}
+
+// Odczyt kolejnej liczby z sekcji danych
+double next_value(istream& in, const string& filename, const string& section) {
+    double value;
+    if (!(in >> value)) {
+        fail(filename, "niekompletna sekcja " + section);
+    }
+    return value;
+}
+
+} // namespace
+
+double TsplibInstance::distance(int i, int j) const {
+    switch (edgeWeightType) {
+    case EdgeWeightType::Explicit:
+        return weights(i, j);
+    case EdgeWeightType::Euc2d:
+        return nint(hypot(x[i] - x[j], y[i] - y[j]));
+    case EdgeWeightType::Ceil2d:
+        return ceil(hypot(x[i] - x[j], y[i] - y[j]));
+    case EdgeWeightType::Geo: {
+        if (i == j) {
+            return 0.0;
+        }
+        const double RRR = GEO_EARTH_RADIUS;
+        double latitudeI = geo_radians(x[i]), longitudeI = geo_radians(y[i]);
+        double latitudeJ = geo_radians(x[j]), longitudeJ = geo_radians(y[j]);
+        double q1 = cos(longitudeI - longitudeJ);
+        double q2 = cos(latitudeI - latitudeJ);
+        double q3 = cos(latitudeI + latitudeJ);
+        return static_cast<int>(RRR * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+    }
+    case EdgeWeightType::Att: {
+        double dx = x[i] - x[j];
+        double dy = y[i] - y[j];
+        double r = sqrt((dx * dx + dy * dy) / 10.0);
+        double t = nint(r);
+        return t < r ? t + 1.0 : t;
+    }
+    }
+    return 0.0;
+}
+
+DistanceMatrix TsplibInstance::distance_matrix() && {
+    if (edgeWeightType == EdgeWeightType::Explicit) {
+        return move(weights);
+    }
+    return static_cast<const TsplibInstance&>(*this).distance_matrix();
+}
+
+DistanceMatrix TsplibInstance::distance_matrix() const& {
+    if (edgeWeightType == EdgeWeightType::Explicit) {
+        return weights;
+    }
+    int n = size();
+    DistanceMatrix matrix(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            matrix(i, j) = matrix(j, i) = distance(i, j);
+        }
+    }
+    matrix.update_symmetry();
+    return matrix;
+}
+
+HaversineDistances TsplibInstance::geo_distances() const {
+    // Stopnie przeskalowane tak, by przeliczenie na radiany z dokładnym pi dało
+    // radiany TSPLIB (geo_radians z PI = 3.141592)
+    vector<double> latitude(x.size()), longitude(y.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        latitude[i] = geo_radians(x[i]) * 180.0 / M_PI;
+        longitude[i] = geo_radians(y[i]) * 180.0 / M_PI;
+    }
+    return HaversineDistances(latitude, longitude, GEO_EARTH_RADIUS, DistanceRounding::Geo);
+}
+
+vector<string> TsplibInstance::city_names() const {
+    vector<string> names(size());
+    for (int i = 0; i < size(); ++i) {
+        names[i] = to_string(i + 1);
+    }
+    return names;
+}
+
+bool is_tsplib_file(const string& filename) {
+    ifstream file(filename);
+    string line;
+    while (getline(file, line)) {
+        if (trim(line).empty()) {
+            continue;
+        }
+        auto [keyword, value] = split_keyword(line);
+        return keyword == "NAME" || keyword == "TYPE" || keyword == "COMMENT" || keyword == "DIMENSION";
+    }
+    return false;
+}
+
+TsplibInstance read_tsplib(const string& filename) {
+    ifstream file(filename);
+    if (!file) {
+        cerr << "Nie można otworzyć pliku: " << filename << endl;
+        exit(1);
+    }
+
+    TsplibInstance instance;
+    int dimension = 0;
+    string edgeWeightFormat;
+    bool haveCoordinates = false;
+    bool haveWeights = false;
+
+    string line;
+    while (getline(file, line)) {
+        auto [keyword, value] = split_keyword(line);
+        if (keyword.empty()) {
+            continue;
+        }
+        if (keyword == "EOF") {
+            break;
+        }
+        if (keyword == "NAME") {
+            instance.name = value;
+        } else if (keyword == "TYPE") {
+            if (value == "ATSP") {
+                instance.asymmetric = true;
+            } else if (value != "TSP") {
+                fail(filename, "nieobsługiwany typ problemu " + value);
+            }
+        } else if (keyword == "DIMENSION") {
+            dimension = atoi(value.c_str());
+            if (dimension <= 0) {
+                fail(filename, "niepoprawny wymiar " + value);
+            }
+        } else if (keyword == "EDGE_WEIGHT_TYPE") {
+            if (value == "EXPLICIT") {
+                instance.edgeWeightType = EdgeWeightType::Explicit;
+            } else if (value == "EUC_2D") {
+                instance.edgeWeightType = EdgeWeightType::Euc2d;
+            } else if (value == "CEIL_2D") {
+                instance.edgeWeightType = EdgeWeightType::Ceil2d;
+            } else if (value == "GEO") {
+                instance.edgeWeightType = EdgeWeightType::Geo;
+            } else if (value == "ATT") {
+                instance.edgeWeightType = EdgeWeightType::Att;
+            } else {
+                fail(filename, "nieobsługiwany typ wag " + value);
+            }
+        } else if (keyword == "EDGE_WEIGHT_FORMAT") {
+            edgeWeightFormat = value;
+        } else if (keyword == "NODE_COORD_SECTION") {
+            if (dimension == 0) {
+                fail(filename, "brak DIMENSION przed NODE_COORD_SECTION");
+            }
+            instance.x.assign(dimension, 0.0);
+            instance.y.assign(dimension, 0.0);
+            vector<char> seen(dimension, 0);
+            for (int k = 0; k < dimension; ++k) {
+                int node = static_cast<int>(next_value(file, filename, keyword));
+                if (node < 1 || node > dimension || seen[node - 1]) {
+                    fail(filename, "niepoprawny numer węzła " + to_string(node));
+                }
+                seen[node - 1] = 1;
+                instance.x[node - 1] = next_value(file, filename, keyword);
+                instance.y[node - 1] = next_value(file, filename, keyword);
+            }
+            haveCoordinates = true;
+        } else if (keyword == "EDGE_WEIGHT_SECTION") {
+            if (dimension == 0) {
+                fail(filename, "brak DIMENSION przed EDGE_WEIGHT_SECTION");
+            }
+            int n = dimension;
+            DistanceMatrix weights(n);
+            // Każdy format trójkątny to przebieg wierszami po części macierzy
+            // (z przekątną lub bez), uzupełniany symetrycznie
+            auto read_triangle = [&](bool upper, bool diagonal) {
+                for (int i = 0; i < n; ++i) {
+                    int first = upper ? (diagonal ? i : i + 1) : 0;
+                    int last = upper ? n : (diagonal ? i + 1 : i);
+                    for (int j = first; j < last; ++j) {
+                        weights(i, j) = weights(j, i) = next_value(file, filename, keyword);
+                    }
+                }
+            };
+            if (edgeWeightFormat == "FULL_MATRIX") {
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < n; ++j) {
+                        weights(i, j) = next_value(file, filename, keyword);
+                    }
+                }
+            } else if (edgeWeightFormat == "UPPER_ROW") {
+                read_triangle(true, false);
+            } else if (edgeWeightFormat == "UPPER_DIAG_ROW") {
+                read_triangle(true, true);
+            } else if (edgeWeightFormat == "LOWER_ROW") {
+                read_triangle(false, false);
+            } else if (edgeWeightFormat == "LOWER_DIAG_ROW") {
+                read_triangle(false, true);
+            } else {
+                fail(filename, "nieobsługiwany format wag '" + edgeWeightFormat + "'");
+            }
+            for (int i = 0; i < n; ++i) {
+                weights(i, i) = 0.0;
+            }
+            weights.update_symmetry();
+            instance.weights = move(weights);
+            haveWeights = true;
+        } else if (keyword == "DISPLAY_DATA_SECTION") {
+            // Współrzędne tylko do rysowania - pomijamy
+            for (int k = 0; k < 3 * dimension; ++k) {
+                next_value(file, filename, keyword);
+            }
+        } else if (keyword == "FIXED_EDGES_SECTION") {
+            while (next_value(file, filename, keyword) != -1) {
+            }
+        }
+        // Pozostałe słowa kluczowe (COMMENT, DISPLAY_DATA_TYPE, ...) nie wpływają na odległości
+    }
+
+    if (instance.edgeWeightType == EdgeWeightType::Explicit ? !haveWeights : !haveCoordinates) {
+        fail(filename, "brak sekcji z danymi instancji");
+    }
+    if (instance.edgeWeightType != EdgeWeightType::Explicit) {
+        instance.weights = DistanceMatrix();
+    }
+    return instance;
+}
@@ -0,0 +1,60 @@
+#ifndef TSPLIB_H
+#define TSPLIB_H
+
+#include <string>
+#include <vector>
+#include "coordinate_distances.h"
+#include "distance_matrix.h"
+
+using namespace std;
+
+// Sposób liczenia odległości w instancji TSPLIB (EDGE_WEIGHT_TYPE)
+enum class EdgeWeightType {
+    Explicit,  // macierz wag podana w pliku (EDGE_WEIGHT_SECTION)
+    Euc2d,     // odległość euklidesowa zaokrąglona do najbliższej liczby całkowitej
+    Ceil2d,    // odległość euklidesowa zaokrąglona w górę
+    Geo,       // odległość na kuli ziemskiej, współrzędne w formacie stopnie.minuty
+    Att        // pseudo-euklidesowa odległość instancji att48 / att532
+};
+
+// Promień Ziemi w kilometrach przyjęty w definicji typu GEO
+constexpr double GEO_EARTH_RADIUS = 6378.388;
+
+// Instancja TSPLIB. Dla typów współrzędnych przechowywane są tylko współrzędne
+// (x - szerokość, y - długość geograficzna dla GEO), a odległości liczone są
+// na żądanie zgodnie z definicjami TSPLIB (zaokrąglenia do liczb całkowitych).
+// Dla EXPLICIT wagi trafiają od razu do macierzy.
+struct TsplibInstance {
+    string name;
+    bool asymmetric = false;  // TYPE: ATSP
+    EdgeWeightType edgeWeightType = EdgeWeightType::Explicit;
+    vector<double> x;
+    vector<double> y;
+    DistanceMatrix weights;   // tylko EXPLICIT
+
+    int size() const { return edgeWeightType == EdgeWeightType::Explicit ? weights.size() : x.size(); }
+
+    double distance(int i, int j) const;
+
+    // Pełna macierz odległości dla algorytmów pracujących na macierzy; wersja
+    // dla instancji tymczasowej przenosi wagi EXPLICIT zamiast je kopiować
+    DistanceMatrix distance_matrix() const&;
+    DistanceMatrix distance_matrix() &&;
+
+    // Odległości instancji GEO liczone na żądanie ze współrzędnych - te same
+    // liczby całkowite int(d + 1) co distance() i macierz z distance_matrix()
+    HaversineDistances geo_distances() const;
+
+    // Nazwy miast - numery węzłów z pliku (od 1)
+    vector<string> city_names() const;
+};
+
+// Czy plik wygląda na instancję TSPLIB (nagłówek "KLUCZ : wartość")
+bool is_tsplib_file(const string& filename);
+
+// Wczytuje plik strumieniowo (nagłówek wierszami, sekcje danych liczba po liczbie).
+// Obsługiwane typy: EUC_2D, CEIL_2D, GEO, ATT oraz EXPLICIT w formatach FULL_MATRIX,
+// UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW i LOWER_DIAG_ROW. Błąd kończy program.
+TsplibInstance read_tsplib(const string& filename);
+
+#endif // TSPLIB_H